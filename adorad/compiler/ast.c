@@ -11,4 +11,270 @@ SPDX-License-Identifier: MIT
 Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 */
 
-#include <adorad/compiler/ast.h>
\ No newline at end of file
+#include <stdlib.h>
+#include <string.h>
+
+#include <adorad/compiler/ast.h>
+#include <adorad/core/debug.h>
+
+// Create a new FlatAst with space for `cap` nodes
+FlatAst* flatast_new(UInt32 cap) {
+    if(cap == 0)
+        cap = 1;
+
+    FlatAst* ast = cast(FlatAst*)calloc(1, sizeof(FlatAst));
+    CORETEN_ENFORCE_NN(ast, "Could not allocate memory. Memory full.");
+    ast->kinds = cast(UInt8*)malloc(cap * sizeof(UInt8));
+    ast->main_tokens = cast(TokenIndex*)malloc(cap * sizeof(TokenIndex));
+    ast->lhs = cast(UInt32*)malloc(cap * sizeof(UInt32));
+    ast->rhs = cast(UInt32*)malloc(cap * sizeof(UInt32));
+    CORETEN_ENFORCE(ast->kinds && ast->main_tokens && ast->lhs && ast->rhs, "Could not allocate memory. Memory full.");
+    ast->cap = cap;
+    return ast;
+}
+
+void flatast_free(FlatAst* ast) {
+    if(ast) {
+        free(ast->kinds);
+        free(ast->main_tokens);
+        free(ast->lhs);
+        free(ast->rhs);
+        free(ast->extra_data);
+        free(ast);
+    }
+}
+
+// Resize the arrays of the FlatAst to hold `cap` nodes
+static void flatast_resize(FlatAst* ast, UInt32 cap) {
+    ast->kinds = cast(UInt8*)realloc(ast->kinds, cap * sizeof(UInt8));
+    ast->main_tokens = cast(TokenIndex*)realloc(ast->main_tokens, cap * sizeof(TokenIndex));
+    ast->lhs = cast(UInt32*)realloc(ast->lhs, cap * sizeof(UInt32));
+    ast->rhs = cast(UInt32*)realloc(ast->rhs, cap * sizeof(UInt32));
+    CORETEN_ENFORCE(ast->kinds && ast->main_tokens && ast->lhs && ast->rhs, "Could not allocate memory. Memory full.");
+    ast->cap = cap;
+}
+
+AstIndex flatast_push(FlatAst* ast, AstNodeKind kind, TokenIndex main_token, UInt32 lhs, UInt32 rhs) {
+    if(ast->size == ast->cap)
+        flatast_resize(ast, ast->cap * 2);
+    AstIndex index = ast->size++;
+    flatast_set(ast, index, kind, main_token, lhs, rhs);
+    return index;
+}
+
+void flatast_set(FlatAst* ast, AstIndex index, AstNodeKind kind, TokenIndex main_token, UInt32 lhs, UInt32 rhs) {
+    CORETEN_ENFORCE(index < ast->size, "AstIndex out of bounds");
+    ast->kinds[index] = cast(UInt8)kind;
+    ast->main_tokens[index] = main_token;
+    ast->lhs[index] = lhs;
+    ast->rhs[index] = rhs;
+}
+
+FlatAstNode flatast_at(FlatAst* ast, AstIndex index) {
+    CORETEN_ENFORCE(index < ast->size, "AstIndex out of bounds");
+    FlatAstNode node;
+    node.kind = cast(AstNodeKind)ast->kinds[index];
+    node.main_token = ast->main_tokens[index];
+    node.lhs = ast->lhs[index];
+    node.rhs = ast->rhs[index];
+    return node;
+}
+
+UInt32 flatast_push_extra(FlatAst* ast, const UInt32* values, UInt32 count) {
+    if(ast->num_extra + count > ast->cap_extra) {
+        UInt32 cap = ast->cap_extra ? ast->cap_extra * 2 : 256;
+        while(cap < ast->num_extra + count)
+            cap *= 2;
+        ast->extra_data = cast(UInt32*)realloc(ast->extra_data, cap * sizeof(UInt32));
+        CORETEN_ENFORCE_NN(ast->extra_data, "Could not allocate memory. Memory full.");
+        ast->cap_extra = cap;
+    }
+    UInt32 start = ast->num_extra;
+    if(count > 0)
+        memcpy(ast->extra_data + start, values, count * sizeof(UInt32));
+    ast->num_extra += count;
+    return start;
+}
+
+UInt32 flatast_push_list(FlatAst* ast, const AstIndex* nodes, UInt32 count) {
+    UInt32 range[2];
+    range[0] = flatast_push_extra(ast, nodes, count);
+    range[1] = range[0] + count;
+    return flatast_push_extra(ast, range, 2);
+}
+
+const AstIndex* flatast_list(FlatAst* ast, UInt32 extra, UInt32* count) {
+    CORETEN_ENFORCE(extra + 1 < ast->num_extra, "Index into extra_data out of bounds");
+    UInt32 start = ast->extra_data[extra];
+    UInt32 end = ast->extra_data[extra + 1];
+    CORETEN_ENFORCE(start <= end && end <= ast->num_extra, "Invalid list in extra_data");
+    *count = end - start;
+    return ast->extra_data + start;
+}
+
+// Layout written by `flatast_write()` (native byte order):
+//      FlatAstHeader
+//      kinds           UInt8[num_nodes]
+//      main_tokens     UInt32[num_nodes]
+//      lhs             UInt32[num_nodes]
+//      rhs             UInt32[num_nodes]
+//      extra_data      UInt32[num_extra]
+#define FLATAST_MAGIC   0x54534441  // "ADST"
+
+typedef struct FlatAstHeader {
+    UInt32 magic;       // FLATAST_MAGIC (this also rejects ASTs written with the other byte order)
+    UInt32 version;     // FLATAST_VERSION
+    UInt32 num_nodes;
+    UInt32 num_extra;
+} FlatAstHeader;
+
+bool flatast_write(FlatAst* ast, FILE* file) {
+    FlatAstHeader header;
+    header.magic = FLATAST_MAGIC;
+    header.version = FLATAST_VERSION;
+    header.num_nodes = ast->size;
+    header.num_extra = ast->num_extra;
+    return fwrite(&header, sizeof(header), 1, file) == 1 &&
+           fwrite(ast->kinds, sizeof(UInt8), ast->size, file) == ast->size &&
+           fwrite(ast->main_tokens, sizeof(TokenIndex), ast->size, file) == ast->size &&
+           fwrite(ast->lhs, sizeof(UInt32), ast->size, file) == ast->size &&
+           fwrite(ast->rhs, sizeof(UInt32), ast->size, file) == ast->size &&
+           fwrite(ast->extra_data, sizeof(UInt32), ast->num_extra, file) == ast->num_extra;
+}
+
+FlatAst* flatast_read(const char* data, UInt64 len) {
+    FlatAstHeader header;
+    if(len < sizeof(header))
+        return null;
+    memcpy(&header, data, sizeof(header));
+    if(header.magic != FLATAST_MAGIC || header.version != FLATAST_VERSION)
+        return null;
+    UInt64 num_nodes = header.num_nodes;
+    UInt64 num_extra = header.num_extra;
+    if(len != sizeof(header) + num_nodes * (sizeof(UInt8) + 3 * sizeof(UInt32)) + num_extra * sizeof(UInt32))
+        return null;
+
+    FlatAst* ast = flatast_new(header.num_nodes);
+    const char* in = data + sizeof(header);
+    memcpy(ast->kinds, in, num_nodes * sizeof(UInt8));
+    in += num_nodes * sizeof(UInt8);
+    memcpy(ast->main_tokens, in, num_nodes * sizeof(TokenIndex));
+    in += num_nodes * sizeof(TokenIndex);
+    memcpy(ast->lhs, in, num_nodes * sizeof(UInt32));
+    in += num_nodes * sizeof(UInt32);
+    memcpy(ast->rhs, in, num_nodes * sizeof(UInt32));
+    in += num_nodes * sizeof(UInt32);
+    ast->size = header.num_nodes;
+    flatast_push_extra(ast, cast(const UInt32*)in, header.num_extra);
+    return ast;
+}
+
+// Flatten every node of `nodes` (which can be null) and append them to `extra_data` as a list
+static UInt32 flatast_push_nodes(FlatAst* ast, Vec* nodes) {
+    UInt32 count = nodes != null ? cast(UInt32)vec_size(nodes) : 0;
+    AstIndex* indices = cast(AstIndex*)malloc((count + 1) * sizeof(AstIndex));
+    CORETEN_ENFORCE_NN(indices, "Could not allocate memory. Memory full.");
+    for(UInt32 i = 0; i < count; i++)
+        indices[i] = flatast_from_node(ast, cast(AstNode*)vec_at(nodes, i));
+    UInt32 list = flatast_push_list(ast, indices, count);
+    free(indices);
+    return list;
+}
+
+AstIndex flatast_from_node(FlatAst* ast, AstNode* node) {
+    if(node == null)
+        return AST_NONE;
+
+    // Pushed ahead of its children, and filled in once their indices are known
+    AstIndex index = flatast_push(ast, node->kind, node->main_token, AST_NONE, AST_NONE);
+    UInt32 lhs = AST_NONE;
+    UInt32 rhs = AST_NONE;
+    UInt32 extra[3];
+    switch(node->kind) {
+        case AstNodeKindBlock:
+            lhs = flatast_push_nodes(ast, node->data.stmt->block_stmt->statements);
+            break;
+        case AstNodeKindBinaryOpExpr:
+            lhs = flatast_from_node(ast, node->data.expr->binary_op_expr->lhs);
+            rhs = flatast_from_node(ast, node->data.expr->binary_op_expr->rhs);
+            break;
+        case AstNodeKindPrefixOpExpr:
+            lhs = flatast_from_node(ast, node->data.prefix_op_expr->expr);
+            break;
+        case AstNodeKindFieldAccessExpr:
+            lhs = flatast_from_node(ast, node->data.field_access_expr->struct_expr);
+            rhs = node->main_token + 1; // DOT IDENTIFIER
+            break;
+        case AstNodeKindArrayAccessExpr:
+            lhs = flatast_from_node(ast, node->data.array_access_expr->array_ref_expr);
+            rhs = flatast_from_node(ast, node->data.array_access_expr->subscript);
+            break;
+        case AstNodeKindSliceExpr:
+            lhs = flatast_from_node(ast, node->data.expr->slice_expr->array_ref_expr);
+            extra[0] = flatast_from_node(ast, node->data.expr->slice_expr->lower);
+            extra[1] = flatast_from_node(ast, node->data.expr->slice_expr->upper);
+            extra[2] = flatast_from_node(ast, node->data.expr->slice_expr->sentinel);
+            rhs = flatast_push_extra(ast, extra, 3);
+            break;
+        case AstNodeKindFuncCallExpr:
+            lhs = flatast_from_node(ast, node->data.expr->func_call_expr->func_call_expr);
+            rhs = flatast_push_nodes(ast, node->data.expr->func_call_expr->params);
+            break;
+        case AstNodeKindInitExpr:
+            lhs = flatast_from_node(ast, node->data.expr->init_expr->type);
+            rhs = flatast_push_nodes(ast, node->data.expr->init_expr->entries);
+            break;
+        case AstNodeKindIfExpr:
+            lhs = flatast_from_node(ast, node->data.expr->if_expr->condition);
+            extra[0] = flatast_from_node(ast, node->data.expr->if_expr->then_block);
+            extra[1] = flatast_from_node(ast, node->data.expr->if_expr->else_node);
+            rhs = flatast_push_extra(ast, extra, 2);
+            break;
+        case AstNodeKindMatchExpr:
+            lhs = flatast_from_node(ast, node->data.expr->match_expr->expr);
+            rhs = flatast_push_nodes(ast, node->data.expr->match_expr->branches);
+            break;
+        case AstNodeKindMatchBranch:
+            lhs = flatast_push_nodes(ast, node->data.expr->match_branch_expr->branches);
+            rhs = flatast_from_node(ast, node->data.expr->match_branch_expr->expr);
+            break;
+        case AstNodeKindMatchRange:
+            lhs = flatast_from_node(ast, node->data.expr->match_range_expr->begin);
+            rhs = flatast_from_node(ast, node->data.expr->match_range_expr->end);
+            break;
+        case AstNodeKindArrayType:
+            lhs = flatast_from_node(ast, node->data.array_type->size);
+            rhs = flatast_from_node(ast, node->data.array_type->child_type);
+            break;
+        case AstNodeKindVarDecl:
+            lhs = flatast_from_node(ast, node->data.stmt->var_decl->type);
+            rhs = flatast_from_node(ast, node->data.stmt->var_decl->expr);
+            break;
+        case AstNodeKindParamDecl:
+            lhs = flatast_from_node(ast, node->data.param_decl->type);
+            break;
+        case AstNodeKindFuncPrototype:
+            extra[0] = flatast_push_nodes(ast, node->data.stmt->func_proto_decl->params);
+            extra[1] = flatast_from_node(ast, node->data.stmt->func_proto_decl->func_def);
+            lhs = flatast_push_extra(ast, extra, 2);
+            rhs = flatast_from_node(ast, node->data.stmt->func_proto_decl->return_type);
+            break;
+        case AstNodeKindReturn:
+            lhs = flatast_from_node(ast, node->data.stmt->return_stmt->expr);
+            break;
+        case AstNodeKindDefer:
+            lhs = flatast_from_node(ast, node->data.stmt->defer_stmt->expr);
+            break;
+        case AstNodeKindBreak:
+        case AstNodeKindContinue:
+            lhs = flatast_from_node(ast, node->data.stmt->branch_stmt->expr);
+            if(node->data.stmt->branch_stmt->name != null)
+                rhs = node->main_token + 2; // KEYWORD(break) COLON IDENTIFIER
+            break;
+        default:
+            break;
+    }
+
+    flatast_set(ast, index, node->kind, node->main_token, lhs, rhs);
+    return index;
+}
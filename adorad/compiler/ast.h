@@ -14,7 +14,10 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 #ifndef ADORAD_AST_H
 #define ADORAD_AST_H
 
+#include <stdio.h>
+
 #include <adorad/core/types.h>
+#include <adorad/core/misc.h>
 #include <adorad/core/buffer.h>
 #include <adorad/core/vector.h>
 #include <adorad/compiler/location.h>
@@ -518,7 +521,9 @@ typedef struct AstNodeFuncPrototype {
     Buff* name;
     Vec* params;  // Vec<AstNode*>
     AstNode* return_type;
-    AstNode* func_def;
+    AstNode* func_def;      // the body (null until parsed, see `parser_parse_body()`)
+    TokenIndex body_begin;  // LBRACE of a body that hasn't been parsed yet (TOKEN_NONE if there is none)
+    TokenIndex body_end;    // its matching RBRACE
 
     FuncInline func_inline;
     bool is_export;
@@ -833,6 +838,7 @@ typedef struct AstNodeFieldAccessExpr {
 
 struct AstNode {
     AstNodeKind kind; // type of AST Node
+    TokenIndex main_token; // the token the node is anchored to (see the table above `FlatAst`)
     Location* loc;
 
     union {
@@ -854,6 +860,89 @@ struct AstNode {
     } data;
 };
 
+// Index of a node in a `FlatAst`
+typedef UInt32 AstIndex;
+// Stands for a missing child (e.g. the type of a VarDecl that doesn't spell it out)
+#define AST_NONE        cast(AstIndex)(-1)
+
+// Flat AST
+// An alternative encoding of the AST in which every node is 13 bytes (kind + main token + 2 operands) held in
+// parallel arrays, the way a `TokenList` holds tokens. Children are referred to by index, and nodes with a
+// variable number of children (or more than 2 of them) keep those in `extra_data`. Traversal walks dense arrays
+// rather than chasing pointers, and the whole AST can be written out as is (see `flatast_write()`).
+//
+// What `main_token`, `lhs` and `rhs` mean depends on the kind of the node:
+//      kind                    main_token                  lhs                         rhs
+//      Identifier, *Literal    the identifier/literal      -                           -
+//      Block                   `{`                         extra: statements           -
+//      BinaryOpExpr            the operator                left operand                right operand
+//      PrefixOpExpr            the operator                operand                     -
+//      FieldAccessExpr         `.`                         struct expr                 field name (token)
+//      ArrayAccessExpr         `[`                         array expr                  subscript
+//      SliceExpr               `[`                         array expr                  extra: lower, upper, sentinel
+//      FuncCallExpr            `(`                         callee                      extra: args
+//      InitExpr                `{`                         type                        extra: entries
+//      IfExpr                  `if`                        condition                   extra: then, else
+//      MatchExpr               `match`                     subject                     extra: branches
+//      MatchBranch             first item / `else`         extra: items                body
+//      MatchRange              `..`                        begin                       end
+//      ArrayType               `[`                         size                        child type
+//      VarDecl                 the name                    type                        value
+//      ParamDecl               the name                    type                        -
+//      FuncPrototype           the name (or `func`)        extra: params, body         return type
+//      Return, Defer           the keyword                 expr                        -
+//      Break, Continue         the keyword                 expr                        label (token)
+// "extra: a, b" is the index in `extra_data` from which `a` and `b` are stored, and "extra: <list>" the index of a
+// list of nodes in `extra_data` (see `flatast_push_list()`); `params` above is such a list. Unused operands are
+// AST_NONE, and kinds that aren't listed have none.
+typedef struct FlatAst {
+    UInt8* kinds;           // AstNodeKind of each node
+    TokenIndex* main_tokens;// the token each node is anchored to
+    UInt32* lhs;            // first operand of each node
+    UInt32* rhs;            // second operand of each node
+    UInt32 size;            // number of nodes
+    UInt32 cap;             // number of nodes allocated for
+    UInt32* extra_data;     // children that don't fit in `lhs` and `rhs`
+    UInt32 num_extra;       // number of entries in `extra_data`
+    UInt32 cap_extra;       // capacity of `extra_data`
+} FlatAst;
+
+// An unpacked view of a single node of a FlatAst
+typedef struct FlatAstNode {
+    AstNodeKind kind;
+    TokenIndex main_token;
+    UInt32 lhs;
+    UInt32 rhs;
+} FlatAstNode;
+
+// Version of the format written by `flatast_write()`. Bump this whenever the format or the encoding of a node kind
+// changes
+#define FLATAST_VERSION     2
+
+// Create a new FlatAst with space for `cap` nodes
+FlatAst* flatast_new(UInt32 cap);
+void flatast_free(FlatAst* ast);
+// Append a node and return its index
+AstIndex flatast_push(FlatAst* ast, AstNodeKind kind, TokenIndex main_token, UInt32 lhs, UInt32 rhs);
+// Overwrite node `index` (used to fill in a node pushed before its children were known)
+void flatast_set(FlatAst* ast, AstIndex index, AstNodeKind kind, TokenIndex main_token, UInt32 lhs, UInt32 rhs);
+// Returns node `index`
+FlatAstNode flatast_at(FlatAst* ast, AstIndex index);
+// Append `count` values to `extra_data` and return the index of the first one
+UInt32 flatast_push_extra(FlatAst* ast, const UInt32* values, UInt32 count);
+// Append a list of nodes to `extra_data`, followed by its (start, end) range, and return the index of the range
+// (which goes into `lhs` or `rhs`)
+UInt32 flatast_push_list(FlatAst* ast, const AstIndex* nodes, UInt32 count);
+// Returns the list of nodes whose range is at `extra` in `extra_data`, and stores its length in `count`
+const AstIndex* flatast_list(FlatAst* ast, UInt32 extra, UInt32* count);
+// Write the FlatAst to `file`. Returns false if it couldn't be written
+bool flatast_write(FlatAst* ast, FILE* file);
+// Read a FlatAst written by `flatast_write()` back from `len` bytes at `data`. Returns null if they don't hold one
+FlatAst* flatast_read(const char* data, UInt64 len);
+// Append the tree rooted at `node` (as built by the Parser) to the FlatAst and return the index of its root. Nodes
+// come before their children. A function body the Parser skipped (see `parser_set_lazy_bodies()`) is AST_NONE
+AstIndex flatast_from_node(FlatAst* ast, AstNode* node);
+
 // Each Adorad source file can be represented by one AstFile structure.
 typedef struct AstFile {
     Buff* path;     // full path of the source file - `/path/to/file.ad`
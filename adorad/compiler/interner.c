@@ -0,0 +1,112 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+#include <stdlib.h>
+#include <string.h>
+
+#include <adorad/compiler/interner.h>
+#include <adorad/core/debug.h>
+#include <adorad/core/hash.h>
+
+Interner* interner_new() {
+    Interner* interner = cast(Interner*)calloc(1, sizeof(Interner));
+    CORETEN_ENFORCE_NN(interner, "Could not allocate memory. Memory full.");
+    interner->spellings = arena_new(ARENA_DEFAULT_BLOCK_SIZE);
+    interner->cap_atoms = INTERNER_INIT_SLOTS / 2;
+    interner->strs = cast(const char**)malloc(interner->cap_atoms * sizeof(const char*));
+    interner->lens = cast(UInt32*)malloc(interner->cap_atoms * sizeof(UInt32));
+    interner->hashes = cast(UInt32*)malloc(interner->cap_atoms * sizeof(UInt32));
+    interner->slots = cast(Atom*)calloc(INTERNER_INIT_SLOTS, sizeof(Atom));
+    CORETEN_ENFORCE(interner->strs && interner->lens && interner->hashes && interner->slots,
+                    "Could not allocate memory. Memory full.");
+    interner->mask = INTERNER_INIT_SLOTS - 1;
+
+    // Atom 0 is ATOM_NONE
+    interner->strs[ATOM_NONE] = "";
+    interner->lens[ATOM_NONE] = 0;
+    interner->hashes[ATOM_NONE] = 0;
+    interner->num_atoms = 1;
+    return interner;
+}
+
+void interner_free(Interner* interner) {
+    if(interner) {
+        arena_free(interner->spellings);
+        free(interner->strs);
+        free(interner->lens);
+        free(interner->hashes);
+        free(interner->slots);
+        free(interner);
+    }
+}
+
+// Double the number of slots. Every Atom remembers its hash, so no spelling is rehashed.
+static void interner_grow(Interner* interner) {
+    UInt32 num_slots = (interner->mask + 1) * 2;
+    Atom* slots = cast(Atom*)calloc(num_slots, sizeof(Atom));
+    CORETEN_ENFORCE_NN(slots, "Could not allocate memory. Memory full.");
+    for(Atom atom = 1; atom < interner->num_atoms; atom++) {
+        UInt32 slot = interner->hashes[atom] & (num_slots - 1);
+        while(slots[slot] != ATOM_NONE)
+            slot = (slot + 1) & (num_slots - 1);
+        slots[slot] = atom;
+    }
+    free(interner->slots);
+    interner->slots = slots;
+    interner->mask = num_slots - 1;
+
+    // The table is kept at most half full, so there are never more Atoms than half the slots
+    interner->cap_atoms = num_slots / 2;
+    interner->strs = cast(const char**)realloc(interner->strs, interner->cap_atoms * sizeof(const char*));
+    interner->lens = cast(UInt32*)realloc(interner->lens, interner->cap_atoms * sizeof(UInt32));
+    interner->hashes = cast(UInt32*)realloc(interner->hashes, interner->cap_atoms * sizeof(UInt32));
+    CORETEN_ENFORCE(interner->strs && interner->lens && interner->hashes, "Could not allocate memory. Memory full.");
+}
+
+Atom interner_intern(Interner* interner, const char* str, UInt32 len) {
+    UInt32 hash = cast(UInt32)hash_murmur64(str, len);
+    UInt32 slot = hash & interner->mask;
+    for(;;) {
+        Atom atom = interner->slots[slot];
+        if(atom == ATOM_NONE)
+            break;
+        if(interner->hashes[atom] == hash && interner->lens[atom] == len && memcmp(interner->strs[atom], str, len) == 0)
+            return atom;
+        slot = (slot + 1) & interner->mask;
+    }
+
+    // First time we see this spelling
+    if(interner->num_atoms == interner->cap_atoms) {
+        interner_grow(interner);
+        slot = hash & interner->mask;
+        while(interner->slots[slot] != ATOM_NONE)
+            slot = (slot + 1) & interner->mask;
+    }
+
+    char* spelling = cast(char*)arena_alloc(interner->spellings, len + 1, 1);
+    memcpy(spelling, str, len);
+    spelling[len] = '\0';
+
+    Atom atom = interner->num_atoms++;
+    interner->strs[atom] = spelling;
+    interner->lens[atom] = len;
+    interner->hashes[atom] = hash;
+    interner->slots[slot] = atom;
+    return atom;
+}
+
+const char* interner_spelling(Interner* interner, Atom atom, UInt32* len) {
+    CORETEN_ENFORCE(atom < interner->num_atoms, "Invalid Atom");
+    if(len)
+        *len = interner->lens[atom];
+    return interner->strs[atom];
+}
@@ -0,0 +1,54 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+#ifndef ADORAD_INTERNER_H
+#define ADORAD_INTERNER_H
+
+#include <adorad/core/types.h>
+#include <adorad/core/arena.h>
+
+/*
+    Identifier interning
+    Every distinct spelling of an identifier is stored once, and is known by a 32-bit Atom from then on. Two
+    identifiers are the same name if (and only if) their Atoms are equal, so name resolution and symbol tables
+    compare (and hash) integers instead of strings.
+
+    A single Interner is meant to be shared by every file of a compilation (see `lexer_use_interner()`), so that an
+    Atom means the same thing everywhere. An Interner is not thread-safe.
+*/
+
+typedef UInt32 Atom;
+// Not an Atom (the Atom of every token that isn't an IDENTIFIER or a MACRO)
+#define ATOM_NONE       cast(Atom)0
+
+// Initial number of slots in the hash table (a power of 2)
+#define INTERNER_INIT_SLOTS     1024
+
+typedef struct Interner {
+    Arena* spellings;   // the spelling of every Atom (NUL-terminated)
+    const char** strs;  // spelling of each Atom (indexed by Atom; entry 0 is unused)
+    UInt32* lens;       // length of each Atom's spelling (in Bytes)
+    UInt32* hashes;     // hash of each Atom's spelling
+    UInt32 num_atoms;   // number of Atoms (plus one for ATOM_NONE)
+    UInt32 cap_atoms;   // capacity of `strs`, `lens` and `hashes`
+    Atom* slots;        // open-addressing hash table of Atoms (linear probing; ATOM_NONE marks an empty slot)
+    UInt32 mask;        // number of slots minus one
+} Interner;
+
+Interner* interner_new();
+void interner_free(Interner* interner);
+// Returns the Atom of `str` (`len` bytes long), creating one if this is the first time it is seen
+Atom interner_intern(Interner* interner, const char* str, UInt32 len);
+// Returns the spelling of `atom` (NUL-terminated), and stores its length in `len` (if not null)
+const char* interner_spelling(Interner* interner, Atom atom, UInt32* len);
+
+#endif // ADORAD_INTERNER_H
@@ -12,38 +12,52 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 */
 
 #include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <adorad/compiler/lexer.h>
+#include <adorad/core/hash.h>
+
+// SIMD fast paths for the hot loops of the Lexer (see `lexer_skip_whitespace()` and friends)
+// Without any of these, the Lexer falls back to its byte-at-a-time (scalar) loops.
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define LEXER_SIMD_WIDTH    32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LEXER_SIMD_WIDTH    16
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define LEXER_SIMD_WIDTH    16
+#endif
+
+#if defined(LEXER_SIMD_WIDTH) && defined(CORETEN_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+// Integer literals are decoded 8 digits at a time from a little-endian load (see `lexer_load_8()`)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    #define LEXER_BIG_ENDIAN
+#endif
+
+// Worker threads for `lexer_lex_parallel()`
+#if defined(CORETEN_OS_WINDOWS)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
 
 // Get the current character in the Lexical buffer
 // NB: This does not increase the offset
 #define LEXER_CURR_CHAR           buff_at(lexer->buffer, lexer->offset)
 
-// Reset the line
-#define LEXER_RESET_LINENO        lexer->loc->line = 0
-// Reset the column number 
-#define LEXER_RESET_COLNO         lexer->loc->col = 0
-
-// Increment the line number
-#define LEXER_INCREMENT_LINENO    ++lexer->loc->line; LEXER_RESET_COLNO
-// Decrement the line
-#define LEXER_DECREMENT_LINENO    --lexer->loc->line; LEXER_RESET_COLNO
-// Increment the column number
-#define LEXER_INCREMENT_COLNO     ++lexer->loc->col 
-// Decrement the col
-#define LEXER_DECREMENT_COLNO     --lexer->loc->col
-
 // Increment the Lexical Buffer offset
-#define LEXER_INCREMENT_OFFSET    ++lexer->offset; LEXER_INCREMENT_COLNO
+// NB: The Lexer doesn't track the line/col it is at - these are computed on demand (see `lexer_location()`)
+#define LEXER_INCREMENT_OFFSET    ++lexer->offset
 // Decrement the Lexical Buffer offset
-#define LEXER_DECREMENT_OFFSET    --lexer->offset; LEXER_DECREMENT_COLNO
-
-// Increment the Lexical Buffer offset without affecting `col`
-#define LEXER_INCREMENT_OFFSET_ONLY   ++lexer->offset;
-// Decrement the Lexical Buffer offset without affecting `col`
-#define LEXER_DECREMENT_OFFSET_ONLY   --lexer->offset;
+#define LEXER_DECREMENT_OFFSET    --lexer->offset
 
 // Reset the buffer 
 #define LEXER_RESET_BUFFER      \
@@ -53,6 +67,7 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 #define LEXER_RESET             \
     buff_reset(lexer->buffer);  \
     lexer->offset = 0;          \
+    lexer_drop_lines(lexer);    \
     loc_reset(lexer->loc)
 
 // String representation of a TokenKind
@@ -65,6 +80,9 @@ static const char* tokenHash[] = {
     #undef TOKENKIND
 };
 
+// Keyword lookup tables (generated from `ALLTOKENS` by `tools/scripts/generate_tokens.py`)
+#include <adorad/compiler/lexer_tables.h>
+
 // These macros are used in the switch() statements below during the Lexing of Adorad source files.
 #define WHITESPACE_NO_NEWLINE \
     ' ': case '\r': case '\t': case '\v': case '\f'
@@ -89,38 +107,158 @@ static const char* tokenHash[] = {
 #define ALPHA \
          'b': case 'o': case 'x': case 'B': case 'O': case 'X': case ALPHA_EXCEPT_B_O_X
 
+// Estimating the number of tokens
+// Reserving room for every token upfront saves `tokenlist_push()` from growing (and copying) the TokenList over and
+// over on large files. The token density is measured over a few samples spread evenly across the Lexical buffer by a
+// rough scan that counts words, STRINGs, comments and operator bytes. It overestimates a little (`==` counts twice),
+// which is what we want - capacity that is never touched costs next to nothing, while a late reallocation copies the
+// whole TokenList. Smaller buffers simply start out with TOKENLIST_ALLOC_CAPACITY.
+#define LEXER_ESTIMATE_SAMPLES          8
+#define LEXER_ESTIMATE_SAMPLE_SIZE      4096
+
+static inline bool lexer_is_word_byte(UInt8 c) {
+    return cast(UInt8)((c | 0x20) - 'a') < 26 || cast(UInt8)(c - '0') < 10 || c == '_' || c >= 0x80;
+}
+
+// Roughly count the tokens in [begin, end)
+static UInt32 lexer_count_tokens(const char* data, UInt32 begin, UInt32 end) {
+    UInt32 count = 0;
+    UInt32 i = begin;
+    while(i < end) {
+        UInt8 c = cast(UInt8)data[i];
+        if(lexer_is_word_byte(c)) {
+            // A word (or a number, fraction included)
+            while(i < end && (lexer_is_word_byte(cast(UInt8)data[i]) ||
+                              (data[i] == '.' && cast(UInt8)(data[i + 1] - '0') < 10)))
+                i++;
+            count++;
+        } else if(c == '"') {
+            i++;
+            while(i < end && data[i] != '"')
+                i += data[i] == '\\' ? 2 : 1;
+            i++;
+            count++;
+        } else if(c == '#' || (c == '/' && data[i + 1] == '/')) {
+            while(i < end && data[i] != '\n')
+                i++;
+            count++;
+        } else {
+            count += lexerCharClass[c] != 0 || c == '@';
+            i++;
+        }
+    }
+    return count;
+}
+
+// Initial capacity of the TokenList of a Lexer over `data` (`len` bytes long)
+static UInt32 lexer_token_capacity(const char* data, UInt32 len) {
+    if(len <= LEXER_ESTIMATE_SAMPLES * LEXER_ESTIMATE_SAMPLE_SIZE)
+        return TOKENLIST_ALLOC_CAPACITY;
+
+    UInt64 count = 0;
+    UInt32 stride = (len - LEXER_ESTIMATE_SAMPLE_SIZE) / (LEXER_ESTIMATE_SAMPLES - 1);
+    for(UInt32 i = 0; i < LEXER_ESTIMATE_SAMPLES; i++)
+        count += lexer_count_tokens(data, i * stride, i * stride + LEXER_ESTIMATE_SAMPLE_SIZE);
+
+    // Plus the EOF token, and some slack for the parts of the buffer that weren't sampled
+    UInt64 estimate = count * len / (LEXER_ESTIMATE_SAMPLES * LEXER_ESTIMATE_SAMPLE_SIZE) + 1;
+    estimate += estimate / 8;
+    if(estimate < TOKENLIST_ALLOC_CAPACITY)
+        return TOKENLIST_ALLOC_CAPACITY;
+    return estimate < UInt32_MAX ? cast(UInt32)estimate : UInt32_MAX;
+}
 
 Lexer* lexer_init(char* buffer, const char* fname) {
     Lexer* lexer = cast(Lexer*)calloc(1, sizeof(Lexer));
 
     lexer->offset = 0;
     lexer->buffer = buff_new(buffer);
-    lexer->toklist = vec_new(Token, TOKENLIST_ALLOC_CAPACITY);
+    lexer->toklist = tokenlist_new(lexer_token_capacity(lexer->buffer->data, cast(UInt32)buff_len(lexer->buffer)));
     lexer->loc = loc_new(fname);
+    lexer->interner = interner_new();
+    lexer->owns_interner = true;
 
     return lexer;
 }
 
-static void lexer_toklist_push(Lexer* lexer, Token* token) {
-    vec_push(lexer->toklist, token);
+// Lex a file mapped into memory by `file_map()`
+// The Lexer reads the mapped region in place (it never writes to the Lexical buffer), so `file` must outlive it.
+Lexer* lexer_init_mapped(FileMap* file, const char* fname) {
+    Lexer* lexer = cast(Lexer*)calloc(1, sizeof(Lexer));
+
+    lexer->offset = 0;
+    // `file->len` is already known - no need to `strlen()` the whole file
+    lexer->buffer = buff_new(null);
+    lexer->buffer->data = file->contents;
+    lexer->buffer->len = file->len;
+    lexer->toklist = tokenlist_new(lexer_token_capacity(file->contents, cast(UInt32)file->len));
+    lexer->loc = loc_new(fname);
+    lexer->interner = interner_new();
+    lexer->owns_interner = true;
+
+    return lexer;
+}
+
+Lexer* lexer_init_streaming(char* buffer, const char* fname, UInt32 window) {
+    Lexer* lexer = cast(Lexer*)calloc(1, sizeof(Lexer));
+
+    lexer->offset = 0;
+    lexer->buffer = buff_new(buffer);
+    lexer->toklist = tokenlist_new_ring(window);
+    lexer->loc = loc_new(fname);
+    lexer->interner = interner_new();
+    lexer->owns_interner = true;
+
+    return lexer;
 }
 
-static void lexer_free(Lexer* lexer) {
+
+void lexer_free(Lexer* lexer) {
     if(lexer) {
-        vec_free(lexer->toklist);
+        tokenlist_free(lexer->toklist);
+        if(lexer->owns_buffer)
+            free(lexer->buffer->data);
+        free(lexer->line_starts);
+        free(lexer->escaped);
+        free(lexer->ints);
+        free(lexer->trivia);
+        arena_free(lexer->strings);
+        if(lexer->owns_interner)
+            interner_free(lexer->interner);
         buff_free(lexer->buffer);
         loc_free(lexer->loc);
         free(lexer);
     }
 }
 
+void lexer_use_interner(Lexer* lexer, Interner* interner) {
+    if(lexer->owns_interner)
+        interner_free(lexer->interner);
+    lexer->interner = interner;
+    lexer->owns_interner = false;
+}
+
+void lexer_set_trivia(Lexer* lexer, LexerTriviaMode mode) {
+    CORETEN_ENFORCE(lexer->offset == 0, "`lexer_set_trivia()` must be called before lexing");
+    lexer->trivia_mode = cast(UInt8)mode;
+}
+
+void lexer_set_decode_ints(Lexer* lexer, bool decode) {
+    CORETEN_ENFORCE(lexer->offset == 0, "`lexer_set_decode_ints()` must be called before lexing");
+    lexer->decode_ints = decode;
+}
+
 // Report an error and exit
 void lexer_error(Lexer* lexer, Error err, const char* format, ...) {
+    if(lexer->recover)
+        longjmp(*lexer->recover, 1);
+
+    Location loc = lexer_location(lexer, lexer->offset);
     va_list vl;
     va_start(vl, format);
     fprintf(stderr, "%s%s: ", "\033[1;31m", error_str(err));
     vfprintf(stderr, format, vl);
-    fprintf(stderr, " at %s:%d:%d%s\n", lexer->loc->fname->data, lexer->loc->line,lexer->loc->col, "\033[0m");
+    fprintf(stderr, " at %s:%d:%d%s\n", loc.fname->data, loc.line, loc.col, "\033[0m");
     va_end(vl);
     exit(1);
 }
@@ -131,7 +269,6 @@ static inline char lexer_advance(Lexer* lexer) {
     if(lexer->offset >= buff_len(lexer->buffer))
         return nullchar;
     
-    LEXER_INCREMENT_COLNO;
     // Do _not_ use `buff_at(lexer->buffer, lexer->offset++)` here
     return lexer->buffer->data[lexer->offset++];
 }
@@ -142,7 +279,6 @@ static inline char lexer_advancen(Lexer* lexer, UInt32 n) {
     if(lexer->offset + n >= buff_len(lexer->buffer))
         return nullchar;
     
-    lexer->loc->col += n;
     lexer->offset += n;
     return lexer->buffer->data[lexer->offset];
 }
@@ -179,192 +315,767 @@ static inline char lexer_peekn(Lexer* lexer, UInt32 n) {
     return (char)lexer->buffer->data[lexer->offset + n];
 }
 
-static void lexer_maketoken(Lexer* lexer, TokenKind kind, Buff* value, UInt32 offset, UInt32 line, UInt32 col) {  
-    Token* token = token_init();
-    CORETEN_ENFORCE_NN(token, "Could not allocate memory. Memory full.");
+// Append a token to `lexer->toklist`
+// The token is a view into the Lexical buffer: its value is the `len` bytes starting at `offset`.
+static inline void lexer_maketoken(Lexer* lexer, TokenKind kind, UInt32 offset, UInt32 len) {  
+    tokenlist_push(lexer->toklist, kind, offset, len, ATOM_NONE);
+}
+
+// Returns the Atom of the name [offset, offset + len) in the Lexical buffer
+// A Lexer without an Interner (the private Lexers of `lexer_lex_parallel()`) leaves its names to be interned later.
+static inline Atom lexer_intern(Lexer* lexer, UInt32 offset, UInt32 len) {
+    if(!lexer->interner)
+        return ATOM_NONE;
+    return interner_intern(lexer->interner, lexer->buffer->data + offset, len);
+}
+
+// Make an IDENTIFIER or MACRO token (a name, which is interned)
+static inline void lexer_make_name_token(Lexer* lexer, TokenKind kind, UInt32 offset, UInt32 len) {
+    tokenlist_push(lexer->toklist, kind, offset, len, lexer_intern(lexer, offset, len));
+}
+
+// Returns an owned copy of the value of `token`.
+// Tokens only store a view into the Lexical buffer, so this is the only place a token's value is ever copied.
+Buff* lexer_token_value(Lexer* lexer, Token* token) {
+    const char* source = lexer->buffer->data + token->offset;
+    UInt32 len = token->len;
+    if(token->kind == STRING)
+        source = lexer_string_value(lexer, token, &len);
+
+    char* value = cast(char*)calloc(1, len + 1);
+    CORETEN_ENFORCE_NN(value, "Could not allocate memory. Memory full.");
+    memcpy(value, source, len);
+    return buff_new(value);
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// SIMD scanning
+// ---------------------------------------------------------------------------------------------------------------
+// Whitespace, `//` comments, identifiers and strings are scanned LEXER_SIMD_WIDTH bytes at a time. Each block is reduced to a
+// bitmask (bit `i` is set if byte `i` belongs to the run), so the end of a run is a count-trailing-zeros.
+// Blocks are only loaded while they lie entirely inside the Lexical buffer; the tail is handled by the scalar loops.
+#ifdef LEXER_SIMD_WIDTH
+
+#if defined(CORETEN_COMPILER_MSVC)
+static inline UInt32 lexer_ctz(UInt32 x) { unsigned long i; _BitScanForward(&i, x); return cast(UInt32)i; }
+#else
+static inline UInt32 lexer_ctz(UInt32 x) { return cast(UInt32)__builtin_ctz(x); }
+#endif // CORETEN_COMPILER_MSVC
+
+#if LEXER_SIMD_WIDTH == 32
+    #define LEXER_SIMD_FULL_MASK    0xFFFFFFFFU
+#else
+    #define LEXER_SIMD_FULL_MASK    0xFFFFU
+#endif
+
+#if defined(__AVX2__)
+typedef __m256i LexerVec;
+#define lexer_vec_load(p)           _mm256_loadu_si256(cast(const __m256i*)(p))
+#define lexer_vec_set1(c)           _mm256_set1_epi8(c)
+#define lexer_vec_eq(v, c)          _mm256_cmpeq_epi8((v), _mm256_set1_epi8(c))
+#define lexer_vec_or(a, b)          _mm256_or_si256((a), (b))
+#define lexer_vec_mask(v)           cast(UInt32)_mm256_movemask_epi8(v)
+// Bytes in [lo, hi] (unsigned): (v - lo) saturating-minus (hi - lo) is zero only inside the range
+#define lexer_vec_range(v, lo, hi)  \
+    _mm256_cmpeq_epi8(_mm256_subs_epu8(_mm256_sub_epi8((v), _mm256_set1_epi8(lo)), _mm256_set1_epi8((hi) - (lo))), \
+                      _mm256_setzero_si256())
+#elif defined(__ARM_NEON)
+typedef uint8x16_t LexerVec;
+#define lexer_vec_load(p)           vld1q_u8(cast(const UInt8*)(p))
+#define lexer_vec_set1(c)           vdupq_n_u8(c)
+#define lexer_vec_eq(v, c)          vceqq_u8((v), vdupq_n_u8(c))
+#define lexer_vec_or(a, b)          vorrq_u8((a), (b))
+#define lexer_vec_range(v, lo, hi)  vcleq_u8(vsubq_u8((v), vdupq_n_u8(lo)), vdupq_n_u8((hi) - (lo)))
+
+// NEON has no movemask: weight each lane by its bit and sum each half
+static inline UInt32 lexer_vec_mask(uint8x16_t v) {
+    static const UInt8 weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t bits = vandq_u8(v, vld1q_u8(weights));
+    return cast(UInt32)vaddv_u8(vget_low_u8(bits)) | (cast(UInt32)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+#else
+typedef __m128i LexerVec;
+#define lexer_vec_load(p)           _mm_loadu_si128(cast(const __m128i*)(p))
+#define lexer_vec_set1(c)           _mm_set1_epi8(c)
+#define lexer_vec_eq(v, c)          _mm_cmpeq_epi8((v), _mm_set1_epi8(c))
+#define lexer_vec_or(a, b)          _mm_or_si128((a), (b))
+#define lexer_vec_mask(v)           cast(UInt32)_mm_movemask_epi8(v)
+#define lexer_vec_range(v, lo, hi)  \
+    _mm_cmpeq_epi8(_mm_subs_epu8(_mm_sub_epi8((v), _mm_set1_epi8(lo)), _mm_set1_epi8((hi) - (lo))), _mm_setzero_si128())
+#endif
+
+// Mask of whitespace bytes (` `, `\t`, `\n`, `\v`, `\f`, `\r`) in the block at `p`
+static inline UInt32 lexer_simd_whitespace_mask(const char* p) {
+    LexerVec v = lexer_vec_load(p);
+    return lexer_vec_mask(lexer_vec_or(lexer_vec_eq(v, ' '), lexer_vec_range(v, '\t', '\r')));
+}
+
+// Mask of `\n` bytes in the block at `p`
+static inline UInt32 lexer_simd_newline_mask(const char* p) {
+    return lexer_vec_mask(lexer_vec_eq(lexer_vec_load(p), '\n'));
+}
+
+// Mask of identifier bytes ([A-Za-z0-9_]) in the block at `p`
+static inline UInt32 lexer_simd_identifier_mask(const char* p) {
+    LexerVec v = lexer_vec_load(p);
+    // `| 0x20` folds [A-Z] onto [a-z]
+    LexerVec alpha = lexer_vec_range(lexer_vec_or(v, lexer_vec_set1(0x20)), 'a', 'z');
+    LexerVec digit = lexer_vec_range(v, '0', '9');
+    return lexer_vec_mask(lexer_vec_or(lexer_vec_or(alpha, digit), lexer_vec_eq(v, '_')));
+}
+
+// Mask of the bytes that end a run of string contents (`"`, `\\` and NUL) in the block at `p`
+static inline UInt32 lexer_simd_string_mask(const char* p) {
+    LexerVec v = lexer_vec_load(p);
+    return lexer_vec_mask(lexer_vec_or(lexer_vec_or(lexer_vec_eq(v, '"'), lexer_vec_eq(v, '\\')), lexer_vec_eq(v, 0)));
+}
+
+#endif // LEXER_SIMD_WIDTH
+
+// ---------------------------------------------------------------------------------------------------------------
+// Locations
+// ---------------------------------------------------------------------------------------------------------------
+// Neither the Lexer nor its tokens track line/col - only byte offsets. The first time a location is requested
+// (usually for a diagnostic), the offsets at which lines begin are recorded in `lexer->line_starts`, and every
+// location is then a binary search away.
+
+// Record the start of a line in `lexer->line_starts`
+static inline void lexer_push_line(Lexer* lexer, UInt32* cap, UInt32 offset) {
+    if(lexer->num_lines == *cap) {
+        *cap *= 2;
+        lexer->line_starts = cast(UInt32*)realloc(lexer->line_starts, *cap * sizeof(UInt32));
+        CORETEN_ENFORCE_NN(lexer->line_starts, "Could not allocate memory. Memory full.");
+    }
+    lexer->line_starts[lexer->num_lines++] = offset;
+}
+
+// Build `lexer->line_starts` (the first line begins at offset 0, and every other one right after a `\n`)
+static void lexer_index_lines(Lexer* lexer) {
+    const char* data = lexer->buffer->data;
+    UInt32 len = cast(UInt32)buff_len(lexer->buffer);
+    UInt32 cap = 64;
+    lexer->line_starts = cast(UInt32*)malloc(cap * sizeof(UInt32));
+    CORETEN_ENFORCE_NN(lexer->line_starts, "Could not allocate memory. Memory full.");
+    lexer->num_lines = 0;
+    lexer_push_line(lexer, &cap, 0);
+
+    UInt32 i = 0;
+#ifdef LEXER_SIMD_WIDTH
+    for(; i + LEXER_SIMD_WIDTH <= len; i += LEXER_SIMD_WIDTH) {
+        UInt32 mask = lexer_simd_newline_mask(data + i);
+        while(mask) {
+            lexer_push_line(lexer, &cap, i + lexer_ctz(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+#endif // LEXER_SIMD_WIDTH
+    for(; i < len; i++) {
+        if(data[i] == '\n')
+            lexer_push_line(lexer, &cap, i + 1);
+    }
+}
+
+// Forget `lexer->line_starts` (it is rebuilt on demand). Must be called whenever the Lexical buffer changes.
+static inline void lexer_drop_lines(Lexer* lexer) {
+    free(lexer->line_starts);
+    lexer->line_starts = null;
+    lexer->num_lines = 0;
+}
+
+// Returns the location (line, col) of `offset` in the Lexical buffer.
+// Tokens don't store their location, so this is computed (only) when it's required - for diagnostics
+Location lexer_location(Lexer* lexer, UInt32 offset) {
+    if(!lexer->line_starts)
+        lexer_index_lines(lexer);
+    if(offset > buff_len(lexer->buffer))
+        offset = cast(UInt32)buff_len(lexer->buffer);
+
+    // The last line beginning at or before `offset`
+    UInt32 lo = 0, hi = lexer->num_lines - 1;
+    while(lo < hi) {
+        UInt32 mid = hi - (hi - lo) / 2;
+        if(lexer->line_starts[mid] <= offset)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    Location loc;
+    loc.line = lo + 1;
+    loc.col = offset - lexer->line_starts[lo] + 1;
+    loc.fname = lexer->loc->fname;
+    return loc;
+}
+
+// Skip a run of whitespace (newlines included) starting at `lexer->offset`
+static inline void lexer_skip_whitespace(Lexer* lexer) {
+#ifdef LEXER_SIMD_WIDTH
+    while(lexer->offset + LEXER_SIMD_WIDTH <= buff_len(lexer->buffer)) {
+        UInt32 mask = lexer_simd_whitespace_mask(lexer->buffer->data + lexer->offset);
+        UInt32 run = mask == LEXER_SIMD_FULL_MASK ? LEXER_SIMD_WIDTH : lexer_ctz(~mask);
+        lexer->offset += run;
+        if(run < LEXER_SIMD_WIDTH)
+            return;
+    }
+#endif // LEXER_SIMD_WIDTH
+
+    const char* data = lexer->buffer->data;
+    for(;;) {
+        switch(data[lexer->offset]) {
+            case WHITESPACE_NO_NEWLINE: case '\n': LEXER_INCREMENT_OFFSET; break;
+            default: return;
+        }
+    }
+}
+
+// Skip to the end of the current line. The `\n` itself is not consumed.
+static inline void lexer_skip_line(Lexer* lexer) {
+#ifdef LEXER_SIMD_WIDTH
+    while(lexer->offset + LEXER_SIMD_WIDTH <= buff_len(lexer->buffer)) {
+        UInt32 mask = lexer_simd_newline_mask(lexer->buffer->data + lexer->offset);
+        if(mask) {
+            lexer->offset += lexer_ctz(mask);
+            return;
+        }
+        lexer->offset += LEXER_SIMD_WIDTH;
+    }
+#endif // LEXER_SIMD_WIDTH
+
+    const char* data = lexer->buffer->data;
+    while(data[lexer->offset] && data[lexer->offset] != '\n')
+        LEXER_INCREMENT_OFFSET;
+}
+
+// Returns the length (in Bytes) of the non-ASCII character at `offset` if it can begin (`is_start`) or continue an
+// identifier, and 0 otherwise
+static inline UInt32 lexer_unicode_ident_length(Lexer* lexer, UInt32 offset, bool is_start) {
+    Ll nbytes;
+    Rune uc = utf8_decode(lexer->buffer->data + offset, &nbytes);
+    return (is_start ? utf8_is_xid_start(uc) : utf8_is_xid_continue(uc)) ? cast(UInt32)nbytes : 0;
+}
+
+// Skip a run of identifier characters ([A-Za-z0-9_] and XID_Continue) starting at `lexer->offset`
+// The ASCII characters are scanned a block at a time; only a byte with its high bit set (which is what stops the
+// block scan in a non-ASCII identifier) is decoded and looked up in the Unicode tables.
+static inline void lexer_skip_identifier(Lexer* lexer) {
+    const char* data = lexer->buffer->data;
+    for(;;) {
+#ifdef LEXER_SIMD_WIDTH
+        while(lexer->offset + LEXER_SIMD_WIDTH <= buff_len(lexer->buffer)) {
+            UInt32 mask = lexer_simd_identifier_mask(data + lexer->offset);
+            UInt32 run = mask == LEXER_SIMD_FULL_MASK ? LEXER_SIMD_WIDTH : lexer_ctz(~mask);
+            lexer->offset += run;
+            if(run < LEXER_SIMD_WIDTH)
+                break;
+        }
+#endif // LEXER_SIMD_WIDTH
+
+        while(char_is_letter(data[lexer->offset]) || char_is_digit(data[lexer->offset]))
+            LEXER_INCREMENT_OFFSET;
+
+        if(!(data[lexer->offset] & 0x80))
+            return;
+        UInt32 nbytes = lexer_unicode_ident_length(lexer, lexer->offset, false);
+        if(nbytes == 0)
+            return;
+        lexer->offset += nbytes;
+    }
+}
+
+// Trivia
+// With a trivia mode set (see `lexer_set_trivia()`), comments - and whitespace runs - are recorded in a side table
+// keyed by the index of the token that follows them, rather than in the token stream. The Parser never sees them,
+// while a formatter or a documentation generator can still recover all of the source text.
+
+// Append to `lexer->trivia` (trivia is recorded in the order it is lexed, which keeps it sorted)
+static inline void lexer_append_trivia(Lexer* lexer, LexerTrivia trivia) {
+    if(lexer->num_trivia == lexer->cap_trivia) {
+        lexer->cap_trivia = lexer->cap_trivia ? lexer->cap_trivia * 2 : 64;
+        lexer->trivia = cast(LexerTrivia*)realloc(lexer->trivia, lexer->cap_trivia * sizeof(LexerTrivia));
+        CORETEN_ENFORCE_NN(lexer->trivia, "Could not allocate memory. Memory full.");
+    }
+    lexer->trivia[lexer->num_trivia++] = trivia;
+}
 
-    if(!value->data) {
-        value = token_to_buff(kind);
+// Record trivia [offset, offset + len) ahead of the next token
+static inline void lexer_push_trivia(Lexer* lexer, TriviaKind kind, UInt32 offset, UInt32 len) {
+    LexerTrivia trivia = { lexer->toklist->size, offset, len, cast(UInt8)kind };
+    lexer_append_trivia(lexer, trivia);
+}
 
-        if(kind == STRING || kind == IDENTIFIER || kind == INTEGER || kind == HEX_INT || kind == BIN_INT ||
-           kind == OCT_INT)
-            WARN("Expected a token value. Got `null`\n");
+// Index of the first entry of `lexer->trivia` that precedes token `token` or a later one
+static inline UInt32 lexer_find_trivia(Lexer* lexer, TokenIndex token) {
+    UInt32 lo = 0, hi = lexer->num_trivia;
+    while(lo < hi) {
+        UInt32 mid = lo + (hi - lo) / 2;
+        if(lexer->trivia[mid].token < token)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
+    return lo;
+}
 
-    token->kind = kind;
-    token->offset = offset;
-    token->loc->col = col;
-    token->loc->line = line;
-    buff_set(token->value, value->data);
-    buff_set(token->loc->fname, lexer->loc->fname->data);
-    lexer_toklist_push(lexer, token);
+const LexerTrivia* lexer_token_trivia(Lexer* lexer, TokenIndex token, UInt32* count) {
+    UInt32 first = lexer_find_trivia(lexer, token);
+    UInt32 last = first;
+    while(last < lexer->num_trivia && lexer->trivia[last].token == token)
+        last++;
+    *count = last - first;
+    return lexer->trivia + first;
 }
 
 // Scan a comment (single line)
 // We store comments in the lexing phase. The Parser will decide which comments are actually useful and which
 // aren't
-static inline void lexer_lex_sl_comment(Lexer* lexer) {
-    char ch = lexer_advance(lexer);
-    int comment_length = 0;
-    UInt32 prev_offset = lexer->offset - 1;
-    UInt32 line = lexer->loc->line;
-    UInt32 col = lexer->loc->col;
-
-    while(ch && ch != '\n') {
-        ch = lexer_advance(lexer);
-        ++comment_length;
+// When this is called, `lexer->offset` points to the first character after the comment marker (`//` or `#`), which
+// begins at `marker`. The token value is the comment text, excluding the marker and the terminating newline.
+static inline void lexer_lex_sl_comment(Lexer* lexer, UInt32 marker) {
+    UInt32 start = lexer->offset;
+    lexer_skip_line(lexer);
+
+    if(lexer->trivia_mode != LEXER_TRIVIA_NONE) {
+        lexer_push_trivia(lexer, TRIVIA_LINE_COMMENT, marker, lexer->offset - marker);
+        return;
     }
-
-    CORETEN_ENFORCE(ch =='\n');
-    
     // Do not store empty comments
-    if(comment_length == 0) 
+    if(lexer->offset == start)
         return;
 
-    Buff* comment_value = buff_slice(lexer->buffer, prev_offset, comment_length - 1);
-    CORETEN_ENFORCE_NN(comment_value, "`comment_value` must not be null");
-    lexer_maketoken(lexer, COMMENT, comment_value, prev_offset, line, col);
-
-    LEXER_DECREMENT_OFFSET;
+    lexer_maketoken(lexer, COMMENT, start, lexer->offset - start);
 }
 
 // Scan a comment (multi-line)
-// We have no reason, at the moment, to store a multi-line comment as a Token
-static inline void lexer_lex_ml_comment(Lexer* lexer) {
-    char ch = lexer_advance(lexer);
-    bool asterisk_found = false; 
-    while(ch && !(ch == '/' && asterisk_found)) {
-        asterisk_found = false; 
-        while(ch && ch!= '*')
-            ch = lexer_advance(lexer);
-        
-        if(ch == '*')
-            asterisk_found = true;
-
-        ch = lexer_advance(lexer);
-    }
-    ch = lexer_advance(lexer);
+// A multi-line comment is never a Token - it is either dropped or recorded as trivia
+// When this is called, `lexer->offset` points to the first character after the `/*` (which begins at `marker`)
+static inline void lexer_lex_ml_comment(Lexer* lexer, UInt32 marker) {
+    const char* data = lexer->buffer->data;
+    UInt32 i = lexer->offset;
+    while(data[i] && !(data[i] == '*' && data[i + 1] == '/'))
+        ++i;
+    // Skip the closing `*/`
+    lexer->offset = data[i] ? i + 2 : i;
+
+    if(lexer->trivia_mode != LEXER_TRIVIA_NONE)
+        lexer_push_trivia(lexer, TRIVIA_BLOCK_COMMENT, marker, lexer->offset - marker);
 }
 
 // Scan a character
 static inline void lexer_lex_char(Lexer* lexer) {
     char ch = lexer_advance(lexer);
-    if(ch) {
+    if(ch)
         LEXER_INCREMENT_OFFSET;
-        if(ch == '\n') {
-            LEXER_INCREMENT_LINENO;
-            LEXER_RESET_COLNO;
+}
+
+// Decode the escape sequence beginning at `*i` (a `\\`) into `out`, and move `*i` past it. Returns the number of bytes
+// written (at most 4, and never more than the length of the escape sequence).
+// The escape sequences are `\n`, `\t`, `\r`, `\0`, `\a`, `\b`, `\f`, `\v`, `\\`, `\"`, `\'`, `\xHH` (a byte) and
+// `\u{H...}` (a codepoint of 1 to 6 hex digits).
+static inline UInt32 lexer_lex_esc_char(Lexer* lexer, UInt32* i, char* out) {
+    const char* data = lexer->buffer->data;
+    UInt32 at = *i;
+    *i = at + 2;
+    switch(data[at + 1]) {
+        case 'n': *out = '\n'; return 1;
+        case 't': *out = '\t'; return 1;
+        case 'r': *out = '\r'; return 1;
+        case '0': *out = nullchar; return 1;
+        case 'a': *out = '\a'; return 1;
+        case 'b': *out = '\b'; return 1;
+        case 'f': *out = '\f'; return 1;
+        case 'v': *out = '\v'; return 1;
+        case '\\': case '"': case '\'': *out = data[at + 1]; return 1;
+        case 'x':
+            if(!char_is_hex_digit(data[at + 2]) || !char_is_hex_digit(data[at + 3]))
+                break;
+            *out = cast(char)((hexdigit_to_int(data[at + 2]) << 4) | hexdigit_to_int(data[at + 3]));
+            *i = at + 4;
+            return 1;
+        case 'u': {
+            if(data[at + 2] != '{')
+                break;
+            UInt32 j = at + 3;
+            Rune uc = 0;
+            while(char_is_hex_digit(data[j]) && j - (at + 3) < 6)
+                uc = (uc << 4) | cast(Rune)hexdigit_to_int(data[j++]);
+            if(j == at + 3 || data[j] != '}')
+                break;
+            lexer->offset = at;
+            if(uc > CORETEN_RUNE_MAX)
+                lexer_error(lexer, ErrorUnicodePointTooLarge, "Unicode escape `\\u{%X}` is out of range", uc);
+            if(uc >= 0xD800 && uc <= 0xDFFF)
+                lexer_error(lexer, ErrorSyntaxError, "Unicode escape `\\u{%X}` is a surrogate", uc);
+            *i = j + 1;
+            return cast(UInt32)utf8_encode_to(out, uc);
         }
+        default: break;
     }
+    lexer->offset = at;
+    lexer_error(lexer, ErrorSyntaxError, "Invalid escape sequence");
+    return 0;
 }
 
-// Scan an escape char
-static inline void lexer_lex_esc_char(Lexer* lexer) {
+// Index of the first entry of `lexer->escaped` whose offset is at least `offset`
+static inline UInt32 lexer_find_string(Lexer* lexer, UInt32 offset) {
+    UInt32 lo = 0, hi = lexer->num_escaped;
+    while(lo < hi) {
+        UInt32 mid = lo + (hi - lo) / 2;
+        if(lexer->escaped[mid].offset < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
 }
 
-// Scan a macro (begins with `@`)
-static inline void lexer_lex_macro(Lexer* lexer) {
-    char ch = lexer_advance(lexer);
-    int macro_length = 0;
-
-    // Don't include the `@` in the macro symbol name
-    UInt32 prev_offset = lexer->offset;
-    UInt32 line = lexer->loc->line;
-    UInt32 col = lexer->loc->col;
+// Append to `lexer->escaped` (strings are recorded in the order they are lexed, which keeps it sorted)
+static inline void lexer_push_string(Lexer* lexer, LexerString string) {
+    if(lexer->num_escaped == lexer->cap_escaped) {
+        lexer->cap_escaped = lexer->cap_escaped ? lexer->cap_escaped * 2 : 16;
+        lexer->escaped = cast(LexerString*)realloc(lexer->escaped, lexer->cap_escaped * sizeof(LexerString));
+        CORETEN_ENFORCE_NN(lexer->escaped, "Could not allocate memory. Memory full.");
+    }
+    lexer->escaped[lexer->num_escaped++] = string;
+}
 
-    while(char_is_letter(ch) || char_is_digit(ch)) {
-        ch = lexer_advance(lexer);
-        ++macro_length;
+// Decode the escape sequences of the STRING whose contents are [begin, end) into the string arena
+// A decoded value is never longer than its source text, so it is decoded in a single pass.
+static void lexer_decode_string(Lexer* lexer, UInt32 begin, UInt32 end) {
+    const char* data = lexer->buffer->data;
+    if(!lexer->strings)
+        lexer->strings = arena_new(ARENA_DEFAULT_BLOCK_SIZE);
+    char* value = cast(char*)arena_alloc(lexer->strings, end - begin + 1, 1);
+
+    UInt32 len = 0;
+    UInt32 i = begin;
+    while(i < end) {
+        // Copy the run up to the next escape sequence as is
+        const char* escape = cast(const char*)memchr(data + i, '\\', end - i);
+        UInt32 run_end = escape ? cast(UInt32)(escape - data) : end;
+        memcpy(value + len, data + i, run_end - i);
+        len += run_end - i;
+        i = run_end;
+        if(i < end)
+            len += lexer_lex_esc_char(lexer, &i, value + len);
     }
+    value[len] = nullchar;
 
-    if(macro_length > MAX_TOKEN_LENGTH)
-        WARN(A number can never have more than 256 characters);
+    LexerString string = { begin, len, value };
+    lexer_push_string(lexer, string);
+}
 
-    UInt32 offset_diff = lexer->offset - prev_offset;
+// Returns the value of a STRING token
+// Most STRINGs don't contain escape sequences, and their value is simply their source text
+const char* lexer_string_value(Lexer* lexer, Token* token, UInt32* len) {
+    CORETEN_ENFORCE(token->kind == STRING, "`lexer_string_value()` expects a STRING token");
+    UInt32 index = lexer_find_string(lexer, token->offset);
+    if(index < lexer->num_escaped && lexer->escaped[index].offset == token->offset) {
+        *len = lexer->escaped[index].len;
+        return lexer->escaped[index].value;
+    }
+    *len = token->len;
+    return lexer->buffer->data + token->offset;
+}
+
+// Scan a macro (begins with `@`)
+static inline void lexer_lex_macro(Lexer* lexer) {
+    // Don't include the `@` in the macro symbol name
+    UInt32 start = lexer->offset;
+    lexer_skip_identifier(lexer);
 
-    Buff* macro_value = buff_slice(lexer->buffer, prev_offset - 1, offset_diff);
-    CORETEN_ENFORCE_NN(macro_value, "`macro_value` must not be null");
-    lexer_maketoken(lexer, MACRO, macro_value, prev_offset - 1, line, col - 1);
+    UInt32 macro_length = lexer->offset - start;
+    if(macro_length > MAX_TOKEN_LENGTH)
+        WARN(A macro can never have more than 256 characters);
 
-    LEXER_DECREMENT_OFFSET;
+    lexer_make_name_token(lexer, MACRO, start, macro_length);
 }
 
 // Scan a string
+// When this is called, the opening quote (`"`) has already been consumed. The token value is the contents of the
+// string, excluding the quotes (an empty string `""` is a token of length 0).
 static inline void lexer_lex_string(Lexer* lexer) {
-    // We already know that the curr char is _not_ a quote (`"`) since an empty string token (`""`) is
-    // handled by `lexer_lex()`
-    CORETEN_ENFORCE(LEXER_CURR_CHAR != '"');
-    char ch = lexer_advance(lexer);
-    int str_length = 0;
-    UInt32 prev_offset = lexer->offset - 1;
-    UInt32 line = lexer->loc->line;
-    UInt32 col = lexer->loc->col;
+    UInt32 start = lexer->offset;
+    const char* data = lexer->buffer->data;
+    UInt32 i = start;
+    bool has_escapes = false;
     lexer->is_inside_str = true;
 
-    while(ch != '"') {
-        if(ch == '\\') {
-            // lexer_lex_esc_char(lexer);
-            ch = lexer_advance(lexer);
+    // The source is valid UTF-8 (see `lexer_check_utf8()`), so a `"` or `\\` byte is always a character of its own -
+    // never part of a multi-byte sequence
+    for(;;) {
+#ifdef LEXER_SIMD_WIDTH
+        // Jump to the next `"`, `\\` or NUL
+        while(i + LEXER_SIMD_WIDTH <= buff_len(lexer->buffer)) {
+            UInt32 mask = lexer_simd_string_mask(data + i);
+            if(mask) {
+                i += lexer_ctz(mask);
+                break;
+            }
+            i += LEXER_SIMD_WIDTH;
+        }
+#endif // LEXER_SIMD_WIDTH
+
+        if(data[i] == '"')
+            break;
+        if(data[i] == nullchar || (data[i] == '\\' && data[i + 1] == nullchar)) {
+            lexer->offset = cast(UInt32)buff_len(lexer->buffer);
+            lexer_error(lexer, ErrorSyntaxError, "Unterminated string literal");
+        }
+        // Skip over the escaped character (this may be a `"`). Escape sequences are decoded once the end of the
+        // string is known.
+        if(data[i] == '\\') {
+            has_escapes = true;
+            i += 2;
         } else {
-            ch = lexer_advance(lexer);
+            ++i;
         }
-        ++str_length;
     }
     lexer->is_inside_str = false;
 
-    CORETEN_ENFORCE(ch == '"');
-    UInt32 offset_diff = lexer->offset - prev_offset;
+    // Only a STRING with escape sequences needs a value of its own - all others are views into the Lexical buffer
+    if(has_escapes)
+        lexer_decode_string(lexer, start, i);
 
-    // `offset_diff - 1` so as to ignore the closing quote `"`
-    Buff* str_value = buff_slice(lexer->buffer, prev_offset, offset_diff - 1);
-    CORETEN_ENFORCE_NN(str_value, "`str_value` must not be null");
-    lexer_maketoken(lexer, STRING, str_value, prev_offset - 1, line, col - 1);
+    // Skip the closing quote `"` (it isn't part of the token's value)
+    lexer->offset = i + 1;
+    lexer_maketoken(lexer, STRING, start, i - start);
 }
 
-// Returns whether `value` is a keyword or an identifier
-static inline TokenKind lexer_is_keyword_or_identifier(char* value) {
-    // Search `tokenHash` for a match for `value`. 
-    // If we can't find one, we assume an identifier
-    for(TokenKind tokenkind = TOK___KEYWORDS_BEGIN + 1; tokenkind < TOK___KEYWORDS_END; tokenkind++)
-        if(strcmp(tokenHash[tokenkind], value) == 0)
-            return tokenkind; // Found a match
+// Returns whether `value` (of length `len`) is a keyword or an identifier
+static inline TokenKind lexer_is_keyword_or_identifier(const char* value, UInt32 len) {
+    if(len < KEYWORD_MIN_LENGTH || len > KEYWORD_MAX_LENGTH)
+        return IDENTIFIER;
+
+    // Every keyword has its own slot in `keywordSlotKinds`, so a single comparison tells us whether `value`
+    // is a keyword. If it isn't, we assume an identifier
+    UInt32 slot = KEYWORD_HASH(value, len);
+    if(keywordSlotLengths[slot] == len && memcmp(tokenHash[keywordSlotKinds[slot]], value, len) == 0)
+        return cast(TokenKind)keywordSlotKinds[slot];
 
-    // If we're still here, we haven't found a keyword match
     return IDENTIFIER;
 }
 
 // Scan an identifier
-static inline void lexer_lex_identifier(Lexer* lexer) {
-    // When this function is called, we alread know that the first character statisfies the `case ALPHA`.
-    // So, the remaining characters are ALPHA, DIGIT, or `_`
+// When this is called, `lexer->offset` points to the character after the first one (at `start`)
+static inline void lexer_lex_identifier(Lexer* lexer, UInt32 start) {
+    // When this function is called, we alread know that the first character statisfies the `case ALPHA` (or is a
+    // non-ASCII XID_Start character). So, the remaining characters are ALPHA, DIGIT, `_` or XID_Continue
     // Still, we check it either way to ensure sanity.
-    CORETEN_ENFORCE(char_is_letter(lexer_prev(lexer)) || char_is_digit(lexer_prev(lexer)),
+    char first = lexer->buffer->data[start];
+    CORETEN_ENFORCE(char_is_letter(first) || char_is_digit(first) || (first & 0x80),
                "This message means you've encountered a serious bug within Adorad. Please file an issue on "
                "Adorad's Github repo.\nError: `lexer_lex_identifier()` hasn't been called with a valid identifier character");
 
-    UInt32 prev_offset = lexer->offset;
-    UInt32 line = lexer->loc->line;
-    UInt32 col = lexer->loc->col;
-    int ident_length = 0;
-    char ch = lexer_advance(lexer);
-
-    while(char_is_letter(ch) || char_is_digit(ch)) {
-        ch = lexer_advance(lexer);
-        ++ident_length;
-    }
+    lexer_skip_identifier(lexer);
 
+    UInt32 ident_length = lexer->offset - start;
     if(ident_length > MAX_TOKEN_LENGTH)
         WARN(An identifier can never have more than 256 characters);
 
-    UInt32 offset_diff = lexer->offset - prev_offset;
-    Buff* ident_value = buff_slice(lexer->buffer, prev_offset - 1, offset_diff);
-    CORETEN_ENFORCE_NN(ident_value, "`ident_value` must not be null");
-
     // Determine if a keyword or just a regular identifier
-    TokenKind tokenkind = lexer_is_keyword_or_identifier(ident_value->data);
-    lexer_maketoken(lexer, tokenkind, ident_value, prev_offset - 1, line, col - 1);
+    TokenKind tokenkind = lexer_is_keyword_or_identifier(lexer->buffer->data + start, ident_length);
+    if(tokenkind == IDENTIFIER)
+        lexer_make_name_token(lexer, tokenkind, start, ident_length);
+    else
+        lexer_maketoken(lexer, tokenkind, start, ident_length);
+}
+
+// Consume a run of digits (satisfying `is_digit`) with optional `_` separators.
+// Returns the number of digits consumed (separators excluded).
+static inline UInt32 lexer_lex_digit_run(Lexer* lexer, bool (*is_digit)(char)) {
+    UInt32 count = 0;
+    char ch = lexer_peek(lexer);
+    while(is_digit(ch) || ch == '_') {
+        if(ch != '_')
+            ++count;
+        LEXER_INCREMENT_OFFSET;
+        ch = lexer_peek(lexer);
+    }
+    return count;
+}
+
+// Scan an operator, delimiter or separator
+// These are lexed by the DFA in `lexer_tables.h` (generated from `ALLTOKENS`), so adding an operator only requires
+// adding it to `ALLTOKENS` and regenerating the tables. When this is called, `curr` has already been consumed.
+// Returns TOK_ILLEGAL if `curr` cannot begin an operator.
+static inline TokenKind lexer_lex_operator(Lexer* lexer, char curr) {
+    UInt8 state = lexerDfaTransitions[0][lexerCharClass[cast(UInt8)curr]];
+    if(state == 0)
+        return TOK_ILLEGAL;
+
+    // Longest match: every prefix of an operator is itself an operator, so we can stop at the first byte without a
+    // transition. `lexer_peek()` returns `nullchar` (class 0) at the end of the buffer
+    UInt8 next = lexerDfaTransitions[state][lexerCharClass[cast(UInt8)lexer_peek(lexer)]];
+    while(next != 0) {
+        state = next;
+        LEXER_INCREMENT_OFFSET;
+        next = lexerDfaTransitions[state][lexerCharClass[cast(UInt8)lexer_peek(lexer)]];
+    }
+    return cast(TokenKind)lexerDfaAccept[state];
+}
+
+// Integer literals
+// With `lexer->decode_ints` set, the value of every integer literal is decoded as soon as it is lexed, so the Parser
+// doesn't have to scan its digits a second time. Decimal digits are decoded 8 at a time with SWAR arithmetic (the
+// 8 digits are treated as the bytes of a UInt64), which also accumulates up to 19 digits before the (more costly)
+// 128-bit arithmetic is needed.
+
+static const UInt64 lexerPowersOf10[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+// Load 8 bytes so that the first is the lowest byte of the result
+static inline UInt64 lexer_load_8(const char* data) {
+    UInt64 chunk;
+    memcpy(&chunk, data, sizeof(chunk));
+#ifdef LEXER_BIG_ENDIAN
+    chunk = __builtin_bswap64(chunk);
+#endif // LEXER_BIG_ENDIAN
+    return chunk;
+}
+
+// Returns true if the 8 bytes of `chunk` are all decimal digits
+static inline bool lexer_is_8_digits(UInt64 chunk) {
+    return (((chunk + 0x4646464646464646ULL) | (chunk - 0x3030303030303030ULL)) & 0x8080808080808080ULL) == 0;
+}
+
+// Returns the value of the 8 decimal digits in `chunk` (see `lexer_load_8()`)
+static inline UInt64 lexer_parse_8_digits(UInt64 chunk) {
+    chunk -= 0x3030303030303030ULL;
+    // Combine adjacent digits into 2-digit values, then 4-digit values, then the 8-digit value
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+    return chunk;
+}
+
+// Returns the low 64 bits of `a * b`, and stores the high 64 bits in `hi`
+static inline UInt64 lexer_mul_64(UInt64 a, UInt64 b, UInt64* hi) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = cast(unsigned __int128)a * b;
+    *hi = cast(UInt64)(product >> 64);
+    return cast(UInt64)product;
+#else
+    UInt64 a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    UInt64 b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    UInt64 lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi;
+    UInt64 mid = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    *hi = a_hi * b_hi + (hi_lo >> 32) + (mid >> 32);
+    return (mid << 32) | (lo_lo & 0xFFFFFFFF);
+#endif // __SIZEOF_INT128__
+}
+
+// `value = value * mul + add`. Sets `value->overflow` if the result doesn't fit in 128 bits
+static inline void lexer_int_muladd(LexerInt* value, UInt64 mul, UInt64 add) {
+    UInt64 carry, overflow;
+    UInt64 lo = lexer_mul_64(value->lo, mul, &carry);
+    UInt64 hi = lexer_mul_64(value->hi, mul, &overflow) + carry;
+    if(overflow || hi < carry)
+        value->overflow = true;
+    lo += add;
+    if(lo < add && ++hi == 0)
+        value->overflow = true;
+    value->lo = lo;
+    value->hi = hi;
+}
+
+// Decode the decimal digits (and `_` separators) in [data, end)
+static inline void lexer_decode_decimal(const char* data, const char* end, LexerInt* value) {
+    UInt64 pending = 0;         // digits that haven't been added to `value` yet
+    UInt32 num_pending = 0;     // (at most 19, so that `pending` can't overflow)
+    while(data < end && !value->overflow) {
+        UInt64 digits;
+        UInt32 num_digits;
+        UInt64 chunk;
+        if(end - data >= 8 && lexer_is_8_digits(chunk = lexer_load_8(data))) {
+            digits = lexer_parse_8_digits(chunk);
+            num_digits = 8;
+        } else if(*data == '_') {
+            ++data;
+            continue;
+        } else {
+            digits = cast(UInt64)(*data - '0');
+            num_digits = 1;
+        }
+        data += num_digits;
+
+        if(num_pending + num_digits > 19) {
+            lexer_int_muladd(value, lexerPowersOf10[num_pending], pending);
+            pending = 0;
+            num_pending = 0;
+        }
+        pending = pending * lexerPowersOf10[num_digits] + digits;
+        num_pending += num_digits;
+    }
+    lexer_int_muladd(value, lexerPowersOf10[num_pending], pending);
+}
+
+// Decode the hexadecimal, octal or binary digits (and `_` separators) in [data, end), each of which is worth `bits`
+// bits
+static inline void lexer_decode_radix(const char* data, const char* end, UInt32 bits, LexerInt* value) {
+    for(; data < end; ++data) {
+        if(*data == '_')
+            continue;
+        if(value->hi >> (64 - bits)) {
+            value->overflow = true;
+            return;
+        }
+        // `0-9`, `a-f` and `A-F` (only hexadecimal digits have bit 6 set)
+        UInt64 digit = cast(UInt64)((*data & 0xF) + 9 * ((*data >> 6) & 1));
+        value->hi = (value->hi << bits) | (value->lo >> (64 - bits));
+        value->lo = (value->lo << bits) | digit;
+    }
+}
+
+// Index of the first entry of `lexer->ints` whose offset is at least `offset`
+static inline UInt32 lexer_find_int(Lexer* lexer, UInt32 offset) {
+    UInt32 lo = 0, hi = lexer->num_ints;
+    while(lo < hi) {
+        UInt32 mid = lo + (hi - lo) / 2;
+        if(lexer->ints[mid].offset < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Append to `lexer->ints` (integer literals are decoded in the order they are lexed, which keeps it sorted)
+static inline void lexer_push_int(Lexer* lexer, LexerInt value) {
+    if(lexer->num_ints == lexer->cap_ints) {
+        lexer->cap_ints = lexer->cap_ints ? lexer->cap_ints * 2 : 64;
+        lexer->ints = cast(LexerInt*)realloc(lexer->ints, lexer->cap_ints * sizeof(LexerInt));
+        CORETEN_ENFORCE_NN(lexer->ints, "Could not allocate memory. Memory full.");
+    }
+    lexer->ints[lexer->num_ints++] = value;
+}
+
+// Decode the integer literal [begin, end) of kind `tokenkind`
+static void lexer_decode_int(Lexer* lexer, TokenKind tokenkind, UInt32 begin, UInt32 end) {
+    const char* data = lexer->buffer->data;
+    LexerInt value = { begin, false, 0, 0 };
+    switch(tokenkind) {
+        // Skip the `0x`, `0o` or `0b` prefix
+        case HEX_INT: lexer_decode_radix(data + begin + 2, data + end, 4, &value); break;
+        case OCT_INT: lexer_decode_radix(data + begin + 2, data + end, 3, &value); break;
+        case BIN_INT: lexer_decode_radix(data + begin + 2, data + end, 1, &value); break;
+        default: lexer_decode_decimal(data + begin, data + end, &value); break;
+    }
+    lexer_push_int(lexer, value);
+}
+
+static inline bool lexer_is_int(TokenKind tokenkind) {
+    return tokenkind == INTEGER || tokenkind == HEX_INT || tokenkind == BIN_INT || tokenkind == OCT_INT;
+}
 
-    LEXER_DECREMENT_OFFSET;
+const LexerInt* lexer_int_value(Lexer* lexer, Token* token) {
+    CORETEN_ENFORCE(lexer_is_int(token->kind), "`lexer_int_value()` expects an integer literal");
+    UInt32 index = lexer_find_int(lexer, token->offset);
+    if(index == lexer->num_ints || lexer->ints[index].offset != token->offset)
+        return null;
+    return &lexer->ints[index];
 }
 
 // Numeric lexing! Finally, the feast can start.
@@ -373,353 +1084,887 @@ static inline void lexer_lex_digit(Lexer* lexer) {
     // 0o... --> Octal       ("0o"|"0O")[0-7_]+
     // 0b... --> Binary      ("0b"|"0B")[01_]+
     // This cannot be `lexer_advance(lexer)` because we enter here from `lexer_lex()` where we already
-    // know that the first char is a digit value. 
-    // This value needs to be captured as well in `token->value`
+    // know that the first char is a digit value (or a `.` followed by a digit, eg: `.0192`).
+    // This value needs to be captured as well in the token's value
     char ch = lexer_prev(lexer);
-    UInt32 prev_offset = lexer->offset - 1;
-    UInt32 line = lexer->loc->line;
-    UInt32 col = lexer->loc->col - 1;
-    TokenKind tokenkind = TOK_ILLEGAL;
-    int digit_length = 0; // no. of digits in the number
-
-    CORETEN_ENFORCE(char_is_digit(ch));
-    while(char_is_digit(ch)) {
-        // Hex, Octal, or Binary?
-        if(ch == '0') {
-            ch = lexer_advance(lexer);
-            switch(ch) {
-                // Hex
-                case 'x': case 'X':;
-                    // Skip [xX]
-                    ch = lexer_advance(lexer);
-                    int hexcount = 0;
-                    while(char_is_hex_digit(ch)) {
-                        ++hexcount; 
-                        ch = lexer_advance(lexer);
-                    }
-                    if(hexcount == 0)
-                        lexer_error(lexer, ErrorSyntaxError, "Expected hexadecimal digits [0-9A-Fa-f] after `0x`");
-                    
-                    tokenkind = HEX_INT;
-                    digit_length = hexcount + 1; // Account for the '0'
-                    break;
-                // Binary
-                case 'b': case 'B':
-                    // Skip [bB]
-                    ch = lexer_advance(lexer);
-                    int bincount = 0;
-                    while(char_is_binary_digit(ch)) {
-                        ++bincount; 
-                        ch = lexer_advance(lexer);
-                    }
-                    if(bincount == 0)
-                        lexer_error(lexer, ErrorSyntaxError, "Expected binary digit [0-1] after `0b`");
-                    
-                    tokenkind = BIN_INT;
-                    digit_length = bincount + 1; // Account for the '0'
-                    break;
-                // Octal
-                // Depart from the (error-prone) C-style octals with an inital zero e.g 0123
-                // Instead, we support the `0o` or `0O` prefix, like 0o123
-                case 'o': case 'O':
-                    // Skip [oO]
-                    ch = lexer_advance(lexer);
-                    int octcount = 0;
-                    while(char_is_octal_digit(ch)) {
-                        ++octcount; 
-                        ch = lexer_advance(lexer);
-                    }
-                    if(octcount == 0)
-                        lexer_error(lexer, ErrorSyntaxError, "Expected octal digits [0-7] after `0o`");
-                    
-                    tokenkind = OCT_INT;
-                    digit_length = octcount + 1; // Account for the '0'
-                    break;
-                case ALPHA_EXCEPT_B_O_X:
-                    // Error
-                    lexer_error(lexer, ErrorSyntaxError, "Invalid character `%c`. Adorad currently supports [xXbBoO] after `0`", ch);
-                    break;
-                default:
-                    // An integer?
-                    // lexer_error(lexer, ErrorSyntaxError, "Cannot have an integer beginning with `0`");     
-                    break;               
-            } // switch(ch)
-        }
-        // Fractions, or Integer?
-        else {
-            // Normal Floats
-            if(ch == '.' || ch == '_') {
-                ch = lexer_advance(lexer);
-                if(ch == '_')
-                    lexer_error(lexer, ErrorSyntaxError, "Unexpected `_` near `.`");
-            }
-            
-            // Exponents (Float)
-            else if(ch == 'e' || ch == 'E') {
-                // Skip over [eE]
-                ch = lexer_advance(lexer);
-                if(ch == '+' || ch == '-') { 
-                    ch = lexer_advance(lexer);
-                } else {
-                    lexer_error(lexer, ErrorSyntaxError, "Expected [+-] after exponent `e`. Got `%c`", ch);
-                }
-                
-                int exp_digits = 0;
-                while(char_is_digit(ch)) {
-                    ch = lexer_advance(lexer);
-                    ++exp_digits;
-                }
-                if(exp_digits == 0)
-                    lexer_error(lexer, ErrorSyntaxError, "Invalid character after exponent `e`. Expected a digit, got `%c`", ch);
-                
-                // (TODO) Verify this is correct
-                digit_length = exp_digits + 1; // Account for the prev digit
+    UInt32 start = lexer->offset - 1;
+    TokenKind tokenkind = INTEGER;
+
+    CORETEN_ENFORCE(char_is_digit(ch) || ch == '.');
+
+    // Hex, Octal, or Binary?
+    if(ch == '0') {
+        switch(lexer_peek(lexer)) {
+            // Hex
+            case 'x': case 'X':
+                // Skip [xX]
+                LEXER_INCREMENT_OFFSET;
+                if(lexer_lex_digit_run(lexer, char_is_hex_digit) == 0)
+                    lexer_error(lexer, ErrorSyntaxError, "Expected hexadecimal digits [0-9A-Fa-f] after `0x`");
+                tokenkind = HEX_INT;
+                break;
+            // Binary
+            case 'b': case 'B':
+                // Skip [bB]
+                LEXER_INCREMENT_OFFSET;
+                if(lexer_lex_digit_run(lexer, char_is_binary_digit) == 0)
+                    lexer_error(lexer, ErrorSyntaxError, "Expected binary digit [0-1] after `0b`");
+                tokenkind = BIN_INT;
+                break;
+            // Octal
+            // Depart from the (error-prone) C-style octals with an inital zero e.g 0123
+            // Instead, we support the `0o` or `0O` prefix, like 0o123
+            case 'o': case 'O':
+                // Skip [oO]
+                LEXER_INCREMENT_OFFSET;
+                if(lexer_lex_digit_run(lexer, char_is_octal_digit) == 0)
+                    lexer_error(lexer, ErrorSyntaxError, "Expected octal digits [0-7] after `0o`");
+                tokenkind = OCT_INT;
+                break;
+            case ALPHA_EXCEPT_B_O_X:;
+                // Exponents (`0e+1`) and imaginary numbers (`0j`) are handled below
+                char next = lexer_peek(lexer);
+                if(next != 'e' && next != 'E' && next != 'j' && next != 'J')
+                    lexer_error(lexer, ErrorSyntaxError, "Invalid character `%c`. Adorad currently supports [xXbBoO] after `0`",
+                                next);
+                break;
+            default:
+                break;
+        } // switch(ch)
+    }
+
+    if(tokenkind == INTEGER) {
+        // Integer part (the first digit has already been consumed)
+        if(ch != '.')
+            lexer_lex_digit_run(lexer, char_is_digit);
+
+        // Fractions
+        // Don't consume the `.` if it isn't followed by a digit (`1..2`, `x.0.y`)
+        if(ch == '.' || (lexer_peek(lexer) == '.' && char_is_digit(lexer_peekn(lexer, 1)))) {
+            if(ch != '.') {
+                LEXER_INCREMENT_OFFSET;
             }
-            // Imaginary
-            else if(ch == 'j' || ch == 'J') {
-                // digit_length = imag_count;
+            if(lexer_peek(lexer) == '_')
+                lexer_error(lexer, ErrorSyntaxError, "Unexpected `_` near `.`");
+            lexer_lex_digit_run(lexer, char_is_digit);
+            tokenkind = FLOAT_LIT;
+        }
+
+        // Exponents (Float)
+        ch = lexer_peek(lexer);
+        if(ch == 'e' || ch == 'E') {
+            // Skip over [eE]
+            LEXER_INCREMENT_OFFSET;
+            ch = lexer_peek(lexer);
+            if(ch == '+' || ch == '-') {
+                LEXER_INCREMENT_OFFSET;
+            } else {
+                lexer_error(lexer, ErrorSyntaxError, "Expected [+-] after exponent `e`. Got `%c`", ch);
             }
+
+            if(lexer_lex_digit_run(lexer, char_is_digit) == 0)
+                lexer_error(lexer, ErrorSyntaxError, "Invalid character after exponent `e`. Expected a digit, got `%c`",
+                            lexer_peek(lexer));
+            tokenkind = FLOAT_LIT;
         }
-        // ch = lexer_advance(lexer);
-    }
 
-    // CORETEN_ENFORCE(tokenkind != TOK_ILLEGAL);
+        // Imaginary
+        ch = lexer_peek(lexer);
+        if(ch == 'j' || ch == 'J') {
+            LEXER_INCREMENT_OFFSET;
+            tokenkind = IMAG;
+        }
+    }
 
-    int offset_diff = cast(int)(lexer->offset - prev_offset);
-    CORETEN_ENFORCE(offset_diff != 0);
+    UInt32 digit_length = lexer->offset - start;
+    CORETEN_ENFORCE(digit_length != 0);
 
     if(digit_length > MAX_TOKEN_LENGTH)
         WARN(A number can never have more than 256 characters);
 
-    // digit_length can be 0 and we can still have a number. Reasoning is as follows:
-    // This function is guaranteed to be called when there's at least one "number-like". We simply check if
-    // there are more digits to lex.
-    // If digit_length = 0, this means that there's only one digit in the number (eg. 0, 2, 9)
-    Buff* digit_value = buff_slice(lexer->buffer, prev_offset, offset_diff - 1);
-    CORETEN_ENFORCE_NN(digit_value, "`digit_value` must not be null");
-    if(!digit_value)
-        printf("digit_value = null\n");
-    lexer_maketoken(lexer, tokenkind, digit_value, prev_offset, line, col);
+    if(lexer->decode_ints && lexer_is_int(tokenkind))
+        lexer_decode_int(lexer, tokenkind, start, lexer->offset);
+    lexer_maketoken(lexer, tokenkind, start, digit_length);
+}
 
-    LEXER_DECREMENT_OFFSET;
+// Returns the length of the UTF-8 'BOM' marker sequence at the start of the Lexical buffer (0 if there is none)
+// Some UTF8 text may start with a 3-byte 'BOM' marker sequence. If it exists, skip over them because they 
+// are useless bytes. Generally, it is not recommended to add BOM markers to UTF8 texts, but it's not 
+// uncommon (especially on Windows).
+static inline UInt32 lexer_bom_length(Lexer* lexer) {
+    char* data = lexer->buffer->data;
+    if(buff_len(lexer->buffer) >= 3 && data[0] == (char)0xef && data[1] == (char)0xbb && data[2] == (char)0xbf)
+        return 3;
+    return 0;
 }
 
-// Lex the Source files
-static void lexer_lex(Lexer* lexer) {
-    // Some UTF8 text may start with a 3-byte 'BOM' marker sequence. If it exists, skip over them because they 
-    // are useless bytes. Generally, it is not recommended to add BOM markers to UTF8 texts, but it's not 
-    // uncommon (especially on Windows).
-    if(lexer->buffer->data[0] == (char)0xef && lexer->buffer->data[1] == (char)0xbb && lexer->buffer->data[2] == (char)0xbf)
-        lexer_advancen(lexer, 3);
-
-    char next = nullchar;
-    char curr = nullchar;
-    TokenKind tokenkind = TOK_ILLEGAL;
+// Report the first invalid UTF-8 sequence in [begin, end) of the Lexical buffer (if any)
+// The Lexer validates its input once, upfront, so that scanning can assume well-formed UTF-8.
+static inline void lexer_check_utf8(Lexer* lexer, UInt32 begin, UInt32 end) {
+    UInt32 valid = cast(UInt32)utf8_validate(lexer->buffer->data + begin, end - begin);
+    if(begin + valid < end) {
+        lexer->offset = begin + valid;
+        lexer_error(lexer, ErrorInvalidCharacter, "Invalid UTF-8 sequence");
+    }
+}
 
-    while(true) {
-        // `lexer_advance()` returns the current character and moves forward, and `lexer_peek()` returns the current
-        // character (after the advance).
-        // For example, if we start from buff[0], 
-        //      curr = buff[0]
-        //      next = buff[1]
-        curr = lexer_advance(lexer);
-        next = lexer_peek(lexer);
-        tokenkind = TOK_ILLEGAL;
-
-        switch(curr) {
-            case nullchar: goto lex_eof;
-            // The `-1` is there to prevent an ILLEGAL token kind from being appended to `lexer->toklist`
-            // NB: Whitespace as a token is useless for our case (will this change later?)
-            case WHITESPACE_NO_NEWLINE: tokenkind = TOK_NULL; break;
-            case '\n':
-                LEXER_INCREMENT_LINENO;
-                LEXER_RESET_COLNO;
+// Lex a single lexeme (whitespace, a comment or a token) beginning at `lexer->offset`
+// Tokens are appended to `lexer->toklist`. Returns false once the end of the Lexical buffer is reached.
+// Between lexemes, the Lexer carries no state other than `nest_level` (strings and comments are always consumed
+// in full), so lexing can be (re)started at any token boundary.
+static inline bool lexer_lex_step(Lexer* lexer) {
+    // `lexer_advance()` returns the current character and moves forward, and `lexer_peek()` returns the current
+    // character (after the advance).
+    // For example, if we start from buff[0], 
+    //      curr = buff[0]
+    //      next = buff[1]
+    char curr = lexer_advance(lexer);
+    char next = lexer_peek(lexer);
+    TokenKind tokenkind = TOK_ILLEGAL;
+    // The token (if any) begins at `curr`
+    UInt32 start = lexer->offset - 1;
+
+    switch(curr) {
+        case nullchar: return false;
+        // The `-1` is there to prevent an ILLEGAL token kind from being appended to `lexer->toklist`
+        // NB: Whitespace as a token is useless for our case (will this change later?)
+        case WHITESPACE_NO_NEWLINE: case '\n':
+            tokenkind = TOK_NULL;
+            lexer_skip_whitespace(lexer);
+            if(lexer->trivia_mode == LEXER_TRIVIA_ALL)
+                lexer_push_trivia(lexer, TRIVIA_WHITESPACE, start, lexer->offset - start);
+            break;
+        // Identifier
+        case ALPHA: case '_': tokenkind = TOK_NULL; lexer_lex_identifier(lexer, start); break;
+        case DIGIT: tokenkind = TOK_NULL; lexer_lex_digit(lexer); break;
+        case '"': tokenkind = TOK_NULL; lexer_lex_string(lexer); break;
+        case '/':
+            switch(next) {
+                // Add tokenkind here? 
+                // (TODO) jasmcaus
+                case '/': LEXER_INCREMENT_OFFSET; tokenkind = TOK_NULL; lexer_lex_sl_comment(lexer, start); break;
+                case '*': LEXER_INCREMENT_OFFSET; tokenkind = TOK_NULL; lexer_lex_ml_comment(lexer, start); break;
+                default: tokenkind = lexer_lex_operator(lexer, curr); break;
+            }
+            break;
+        case '#': 
+            // Ignore a shebang at the start of the file
+            if(start == lexer_bom_length(lexer) && next == '!' && lexer_peekn(lexer, 1) == '/') {
                 tokenkind = TOK_NULL;
-                break;
-            // Identifier
-            case ALPHA: case '_': tokenkind = TOK_NULL; lexer_lex_identifier(lexer); break;
-            case DIGIT: tokenkind = TOK_NULL; lexer_lex_digit(lexer); break;
-            case '"':
-                switch(next) {
-                    // Empty String literal 
-                    case '"': LEXER_INCREMENT_OFFSET; lexer_maketoken(lexer, STRING, buff_new("\"\""), lexer->offset - 1, 
-                                                                      lexer->loc->line, lexer->loc->col - 1); 
-                              break;
-                    default: tokenkind = TOK_NULL; lexer_lex_string(lexer); break;
-                }
-                break;
-            case ';':  tokenkind = SEMICOLON; break;
-            case ',':  tokenkind = COMMA; break;
-            case '\\': tokenkind = BACKSLASH; break;
-            case '[':  tokenkind = LSQUAREBRACK; break;
-            case ']':  tokenkind = RSQUAREBRACK; break;
-            case '{':  lexer->nest_level++; tokenkind = LBRACE; break;
-            case '}':  lexer->nest_level--; tokenkind = RBRACE; break;
-            case '(':  tokenkind = LPAREN; break;
-            case ')':  tokenkind = RPAREN; break;
-            case '=':
-                switch(next) {
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = EQUALS_EQUALS; break;
-                    case '>': LEXER_INCREMENT_OFFSET; tokenkind = EQUALS_ARROW; break;
-                    default: tokenkind = EQUALS; break;
-                }
-                break;
-            case '+':
-                switch(next) {
-                    // This might be removed at some point. 
-                    // '++' serves no purpose since Adorad doesn't (and won't) support pointer arithmetic.
-                    case '+': LEXER_INCREMENT_OFFSET; tokenkind = PLUS_PLUS; break;
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind  = PLUS_EQUALS; break;
-                    default: tokenkind = PLUS; break;
-                }
-                break;
-            case '-':
-                switch(next) {
-                    // This might be removed at some point. 
-                    // '--' serves no purpose since Adorad doesn't (and won't) support pointer arithmetic.
-                    case '-': LEXER_INCREMENT_OFFSET; tokenkind = MINUS_MINUS; break;
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = MINUS_EQUALS; break;
-                    case '>': LEXER_INCREMENT_OFFSET; tokenkind = RARROW; break;
-                    default: tokenkind = MINUS; break;
-                } 
-                break;
-            case '*':
-                switch(next) {
-                    case '*': LEXER_INCREMENT_OFFSET; tokenkind = MULT_MULT; break;
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = MULT_EQUALS; break;
-                    default: tokenkind = MULT; break;
-                }
-                break;
-            case '/':
-                switch(next) {
-                    // Add tokenkind here? 
-                    // (TODO) jasmcaus
-                    case '/': tokenkind = TOK_NULL; lexer_lex_sl_comment(lexer); break;
-                    case '*': tokenkind = TOK_NULL; lexer_lex_ml_comment(lexer); break;
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = SLASH_EQUALS; break;
-                    default: tokenkind = SLASH; break;
-                }
-                break;
-            case '#': 
-                // Ignore shebang on the first line
-                if(lexer->loc->line == 1 && next == '!' && lexer_peekn(lexer, 1) == '/') {
-                    tokenkind = TOK_NULL;
-                    // Skip till end of line
-                    while(LEXER_CURR_CHAR && (LEXER_CURR_CHAR != '\n' || LEXER_CURR_CHAR != nullchar))
-                        curr = lexer_advance(lexer);
-                }
-                // Comment
-                else {
-                    tokenkind = TOK_NULL;
-                    lexer_lex_sl_comment(lexer);
-                }
-                break;
-            case '!':
-                switch(next) {
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = EXCLAMATION_EQUALS; break;
-                    default: tokenkind = MINUS_MINUS; break;
-                }
-                break;
-            case '%':
-                switch(next) {
-                    case '%': LEXER_INCREMENT_OFFSET; tokenkind = MOD_MOD; break;
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = MOD_EQUALS; break;
-                    default: tokenkind = MOD; break;
-                }
-                break;
-            case '&':
-                switch(next) {
-                    case '&': LEXER_INCREMENT_OFFSET; tokenkind = AND_AND; break;
-                    case '^': LEXER_INCREMENT_OFFSET; tokenkind = AND_NOT; break;
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = AND_EQUALS; break;
-                    default: tokenkind = AND; break;
-                }
-                break;
-            case '|':
-                switch(next) {
-                    case '|': LEXER_INCREMENT_OFFSET; tokenkind = OR_OR; break;
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = OR_EQUALS; break;
-                    default: tokenkind = OR; break;
-                }
-                break;
-            case '^':
-                switch(next) {
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = XOR_EQUALS; break;
-                    default: tokenkind = XOR; break;
-                }
-                break;
-            case '<':
-                switch(next) {
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = LESS_THAN_OR_EQUAL_TO; break;
-                    case '-': LEXER_INCREMENT_OFFSET; tokenkind = LARROW; break;
-                    case '<': 
-                        LEXER_INCREMENT_OFFSET;
-                        char c = lexer_peek(lexer);
-                        if(c == '=') {
-                            LEXER_INCREMENT_OFFSET; tokenkind = LBITSHIFT_EQUALS;
-                        } else {
-                            tokenkind = LBITSHIFT;
-                        }
-                        break;
-                    default: tokenkind = LESS_THAN; break;
-                }
-                break;
-            case '>':
-                switch(next) {
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = GREATER_THAN_OR_EQUAL_TO; break;
-                    case '>': 
-                        LEXER_INCREMENT_OFFSET;
-                        char c = lexer_peek(lexer);
-                        if(c == '=') {
-                            LEXER_INCREMENT_OFFSET; tokenkind = RBITSHIFT_EQUALS;
-                        } else {
-                            tokenkind = RBITSHIFT;
-                        }
-                        break;
-                    default: tokenkind = GREATER_THAN; break;
-                }
-                break;
-            case '~':
-                switch(next) {
-                    case '=': LEXER_INCREMENT_OFFSET; tokenkind = TILDA_EQUALS; break;
-                    default: tokenkind = TILDA; break;
-                }
-                break;
-            case '.':
-                switch(next) {
-                    case '.': 
-                        LEXER_INCREMENT_OFFSET;
-                        char c = lexer_peek(lexer);
-                        if(c == '.') {
-                            LEXER_INCREMENT_OFFSET; tokenkind = ELLIPSIS;
-                        } else {
-                            tokenkind = DDOT;
-                        }
-                        break;
-                    // Fractions are possible here:
-                    // Eg: `.0192` or `.9983838`
-                    case DIGIT: tokenkind = TOK_NULL; lexer_lex_digit(lexer); break;
-                    default: tokenkind = DOT; break;
-                }
-                break;
-            case ':':
-                switch(next) {
-                    case ':': LEXER_INCREMENT_OFFSET; tokenkind = COLON_COLON; break;
-                    default: tokenkind = COLON; break;
+                // Skip till end of line
+                lexer_skip_line(lexer);
+                if(lexer->trivia_mode != LEXER_TRIVIA_NONE)
+                    lexer_push_trivia(lexer, TRIVIA_LINE_COMMENT, start, lexer->offset - start);
+            }
+            // Comment
+            else {
+                tokenkind = TOK_NULL;
+                lexer_lex_sl_comment(lexer, start);
+            }
+            break;
+        case '.':
+            switch(next) {
+                // Fractions are possible here:
+                // Eg: `.0192` or `.9983838`
+                case DIGIT: tokenkind = TOK_NULL; lexer_lex_digit(lexer); break;
+                default: tokenkind = lexer_lex_operator(lexer, curr); break;
+            }
+            break;
+        case '@': tokenkind = TOK_NULL; lexer_lex_macro(lexer); break;
+        // Operators, delimiters and separators
+        default:
+            // Non-ASCII identifier
+            if(curr & 0x80) {
+                UInt32 nbytes = lexer_unicode_ident_length(lexer, start, true);
+                if(nbytes == 0) {
+                    Ll len;
+                    lexer->offset = start;
+                    lexer_error(lexer, ErrorSyntaxError, "Invalid character `U+%04X`",
+                                utf8_decode(lexer->buffer->data + start, &len));
                 }
+                lexer->offset = start + nbytes;
+                tokenkind = TOK_NULL;
+                lexer_lex_identifier(lexer, start);
                 break;
-            case '?': tokenkind = QUESTION; break;
-            case '@': tokenkind = TOK_NULL; lexer_lex_macro(lexer); break;
-            default:
+            }
+            tokenkind = lexer_lex_operator(lexer, curr);
+            if(tokenkind == TOK_ILLEGAL)
                 lexer_error(lexer, ErrorSyntaxError, "Invalid character `%c`", curr);
+            break;
+    } // switch(ch)
+
+    if(tokenkind != TOK_NULL) {
+        if(tokenkind == LBRACE)
+            lexer->nest_level++;
+        else if(tokenkind == RBRACE)
+            lexer->nest_level--;
+        lexer_maketoken(lexer, tokenkind, start, lexer->offset - start);
+    }
+    return true;
+}
+
+// Skip the BOM (if any) at the start of the Lexical buffer
+static inline void lexer_skip_bom(Lexer* lexer) {
+    lexer->offset += lexer_bom_length(lexer);
+}
+
+// Lex the Source files
+void lexer_lex(Lexer* lexer) {
+    lexer_check_utf8(lexer, 0, cast(UInt32)buff_len(lexer->buffer));
+    lexer_skip_bom(lexer);
+
+    while(lexer_lex_step(lexer))
+        ;
+
+    lexer_maketoken(lexer, TOK_EOF, lexer->offset, 0);
+}
+
+// Lex the next token (pull-based)
+// This is what a streaming Lexer (see `lexer_init_streaming()`) is driven by: the Parser pulls tokens as it needs
+// them, and `lexer->toklist` only ever holds the last few, so memory doesn't grow with the size of the file.
+TokenIndex lexer_next_token(Lexer* lexer) {
+    TokenList* list = lexer->toklist;
+    if(list->size > 0 && list->kinds[TOKENLIST_SLOT(list, list->size - 1)] == TOK_EOF)
+        return list->size - 1;
+
+    if(lexer->offset == 0) {
+        lexer_check_utf8(lexer, 0, cast(UInt32)buff_len(lexer->buffer));
+        lexer_skip_bom(lexer);
+    }
+
+    UInt32 size = list->size;
+    while(list->size == size) {
+        if(!lexer_lex_step(lexer)) {
+            lexer_maketoken(lexer, TOK_EOF, lexer->offset, 0);
+            break;
+        }
+    }
+    return list->size - 1;
+}
+
+// Incremental relexing
+// The lexeme of a token is its source text - a token's value excludes the quotes of a STRING, the `//` or `#` of a
+// COMMENT and the `@` of a MACRO, but its lexeme doesn't. `data` is the Lexical buffer `list` was lexed from.
+static inline void lexer_lexeme_bounds(const char* data, TokenList* list, TokenIndex index, UInt32* begin, 
+                                       UInt32* end) {
+    UInt32 offset = list->offsets[index];
+    *begin = offset;
+    *end = offset + list->lens[index];
+    switch(list->kinds[index]) {
+        case STRING: *begin -= 1; *end += 1; break;
+        case COMMENT: *begin -= data[offset - 1] == '#' ? 1 : 2; break;
+        case MACRO: *begin -= 1; break;
+        default: break;
+    }
+}
+
+// How far past the end of a lexeme the Lexer may look before deciding where the lexeme ends (`1.5` vs `1..5`)
+#define LEXER_MAX_LOOKAHEAD     2
+
+// Returns the net number of `{`s in the tokens [begin, end) of `list`
+static inline int lexer_nesting(TokenList* list, TokenIndex begin, TokenIndex end) {
+    int nesting = 0;
+    for(TokenIndex i = begin; i < end; i++) {
+        if(list->kinds[i] == LBRACE)
+            nesting++;
+        else if(list->kinds[i] == RBRACE)
+            nesting--;
+    }
+    return nesting;
+}
+
+// Apply an edit to the Lexical buffer and relex only the tokens affected by it.
+// `removed_len` bytes at `edit_offset` are replaced by `inserted_text`. `lexer` must have been lexed already.
+//
+// Relexing starts at the boundary of the last token that the edit can't have affected (taking lookahead into
+// account) and stops as soon as a new token lines up with an old token that lies entirely after the edit. Between
+// lexemes the Lexer carries no state other than `nest_level` (see `lexer_lex_step()`), so from there on the old
+// tokens are still valid and are simply shifted by the change in length.
+void lexer_relex(Lexer* lexer, UInt32 edit_offset, UInt32 removed_len, const char* inserted_text) {
+    TokenList* old = lexer->toklist;
+    char* old_data = lexer->buffer->data;
+    UInt32 old_len = cast(UInt32)buff_len(lexer->buffer);
+    UInt32 inserted_len = cast(UInt32)strlen(inserted_text);
+    UInt32 edit_end = edit_offset + removed_len;
+    Int64 shift = cast(Int64)inserted_len - removed_len;
+    CORETEN_ENFORCE(edit_end <= old_len, "Edit out of bounds");
+    CORETEN_ENFORCE(old->size > 0, "`lexer_relex()` requires a lexed buffer");
+
+    // The first token that may be affected: the first whose lexeme ends within `LEXER_MAX_LOOKAHEAD` bytes of the
+    // edit. Lexemes don't overlap, so their ends are sorted and we can binary search. The EOF token always qualifies.
+    UInt32 begin, end;
+    TokenIndex lo = 0, hi = old->size - 1;
+    while(lo < hi) {
+        TokenIndex mid = lo + (hi - lo) / 2;
+        lexer_lexeme_bounds(old_data, old, mid, &begin, &end);
+        if(end + LEXER_MAX_LOOKAHEAD > edit_offset)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    TokenIndex first = lo;
+    UInt32 restart = 0;
+    if(first > 0)
+        lexer_lexeme_bounds(old_data, old, first - 1, &begin, &restart);
+
+    // Apply the edit to the buffer
+    UInt32 new_len = old_len - removed_len + inserted_len;
+    char* data = cast(char*)malloc(new_len + 1);
+    CORETEN_ENFORCE_NN(data, "Could not allocate memory. Memory full.");
+    memcpy(data, old_data, edit_offset);
+    memcpy(data + edit_offset, inserted_text, inserted_len);
+    memcpy(data + edit_offset + inserted_len, old_data + edit_end, old_len - edit_end);
+    data[new_len] = nullchar;
+    lexer->buffer->data = data;
+    lexer->buffer->len = new_len;
+    lexer_drop_lines(lexer);
+
+    // The old buffer was valid UTF-8, so only the edit (widened to the characters of the old buffer it cuts through)
+    // needs to be validated
+    UInt32 check_begin = edit_offset;
+    while(check_begin > 0 && check_begin < old_len && (old_data[check_begin] & 0xC0) == 0x80)
+        --check_begin;
+    UInt32 check_end = edit_end;
+    while(check_end < old_len && (old_data[check_end] & 0xC0) == 0x80)
+        ++check_end;
+    lexer_check_utf8(lexer, check_begin, cast(UInt32)(check_end + shift));
+
+    if(restart < lexer_bom_length(lexer))
+        restart = lexer_bom_length(lexer);
+    lexer->offset = restart;
+
+    // The decoded STRINGs from `restart` on are set aside: the ones that are relexed are decoded again, and the ones
+    // after the resynchronization point are shifted along with their tokens
+    UInt32 kept = lexer_find_string(lexer, restart);
+    UInt32 num_tail = lexer->num_escaped - kept;
+    LexerString* tail = cast(LexerString*)malloc((num_tail + 1) * sizeof(LexerString));
+    CORETEN_ENFORCE_NN(tail, "Could not allocate memory. Memory full.");
+    memcpy(tail, lexer->escaped + kept, num_tail * sizeof(LexerString));
+    lexer->num_escaped = kept;
+
+    // Likewise for the decoded integer literals
+    UInt32 kept_ints = lexer_find_int(lexer, restart);
+    UInt32 num_tail_ints = lexer->num_ints - kept_ints;
+    LexerInt* tail_ints = cast(LexerInt*)malloc((num_tail_ints + 1) * sizeof(LexerInt));
+    CORETEN_ENFORCE_NN(tail_ints, "Could not allocate memory. Memory full.");
+    memcpy(tail_ints, lexer->ints + kept_ints, num_tail_ints * sizeof(LexerInt));
+    lexer->num_ints = kept_ints;
+
+    // Likewise for the trivia of the tokens from `first` on
+    UInt32 kept_trivia = lexer_find_trivia(lexer, first);
+    UInt32 num_tail_trivia = lexer->num_trivia - kept_trivia;
+    LexerTrivia* tail_trivia = cast(LexerTrivia*)malloc((num_tail_trivia + 1) * sizeof(LexerTrivia));
+    CORETEN_ENFORCE_NN(tail_trivia, "Could not allocate memory. Memory full.");
+    memcpy(tail_trivia, lexer->trivia + kept_trivia, num_tail_trivia * sizeof(LexerTrivia));
+    lexer->num_trivia = kept_trivia;
+
+    // Relex into a scratch list until we resynchronize with the old token stream
+    TokenList* relexed = tokenlist_new(64);
+    int nest_level = lexer->nest_level;
+    lexer->toklist = relexed;
+    TokenIndex resync = old->size;
+    TokenIndex j = first;
+    while(lexer_lex_step(lexer)) {
+        if(relexed->size == 0)
+            continue;
+        UInt32 last = relexed->size - 1;
+        Int64 offset = relexed->offsets[last];
+        // Skip old tokens that begin before the token we just lexed
+        while(j < old->size - 1 && old->offsets[j] + shift < offset)
+            j++;
+        if(j == old->size - 1 || old->offsets[j] + shift != offset)
+            continue;
+
+        lexer_lexeme_bounds(old_data, old, j, &begin, &end);
+        if(begin >= edit_end && old->kinds[j] == relexed->kinds[last] && old->lens[j] == relexed->lens[last]) {
+            resync = j + 1;
+            break;
+        }
+    }
+    if(resync == old->size) {
+        // We ran into the end of the buffer without resynchronizing: the EOF token is relexed as well
+        lexer_maketoken(lexer, TOK_EOF, lexer->offset, 0);
+    }
+
+    if(resync < old->size) {
+        UInt32 tail_begin = old->offsets[resync];
+        for(UInt32 i = 0; i < num_tail; i++) {
+            if(tail[i].offset >= tail_begin) {
+                tail[i].offset = cast(UInt32)(tail[i].offset + shift);
+                lexer_push_string(lexer, tail[i]);
+            }
+        }
+        for(UInt32 i = 0; i < num_tail_ints; i++) {
+            if(tail_ints[i].offset >= tail_begin) {
+                tail_ints[i].offset = cast(UInt32)(tail_ints[i].offset + shift);
+                lexer_push_int(lexer, tail_ints[i]);
+            }
+        }
+    }
+    free(tail);
+    free(tail_ints);
+
+    // The trivia recorded while relexing is keyed by the indices of `relexed`
+    for(UInt32 i = kept_trivia; i < lexer->num_trivia; i++)
+        lexer->trivia[i].token += first;
+    if(resync < old->size) {
+        for(UInt32 i = 0; i < num_tail_trivia; i++) {
+            if(tail_trivia[i].token >= resync) {
+                tail_trivia[i].token = tail_trivia[i].token - resync + first + relexed->size;
+                tail_trivia[i].offset = cast(UInt32)(tail_trivia[i].offset + shift);
+                lexer_append_trivia(lexer, tail_trivia[i]);
+            }
+        }
+    }
+    free(tail_trivia);
+
+    lexer->nest_level = nest_level + lexer_nesting(relexed, 0, relexed->size) - lexer_nesting(old, first, resync);
+    tokenlist_splice(old, first, resync, relexed, shift);
+    tokenlist_free(relexed);
+    lexer->toklist = old;
+
+    // Leave the Lexer where `lexer_lex()` would have
+    lexer->offset = new_len;
+
+    if(lexer->owns_buffer)
+        free(old_data);
+    lexer->owns_buffer = true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Parallel lexing
+// ---------------------------------------------------------------------------------------------------------------
+// The Lexical buffer is split into chunks that begin right after a newline, and each chunk is lexed on its own
+// thread as if a lexeme began there. That guess only fails when a string or a `/* */` comment spans the newline
+// (or when a whitespace run does - which is harmless), so the chunks are then stitched together in order: a chunk
+// whose guess turns out to be wrong is relexed sequentially from where the previous chunk actually ended, until a
+// token lines up with one of its speculative tokens (see `lexer_relex()` - the same argument applies).
+
+typedef struct LexerChunk {
+    Lexer* lexer;       // private Lexer (the Lexical buffer is shared)
+    UInt32 begin;       // first byte of the chunk
+    UInt32 end;         // one past the last byte of the chunk
+    UInt32 stop;        // offset the speculative lexing stopped at (the end of the lexeme straddling `end`)
+    bool failed;        // set if the speculative lexing ran into an error
+    UInt32 valid;       // length of the valid UTF-8 prefix of the chunk
+} LexerChunk;
+
+// Speculatively lex the lexemes that begin within a chunk. Errors aren't reported here - the chunk is relexed
+// sequentially and the error (if it is real) is reported then.
+static void lexer_lex_chunk(LexerChunk* chunk) {
+    Lexer* lexer = chunk->lexer;
+    // Chunks begin right after a newline, so they can be validated independently
+    chunk->valid = cast(UInt32)utf8_validate(lexer->buffer->data + chunk->begin, chunk->end - chunk->begin);
+    if(chunk->begin + chunk->valid < chunk->end) {
+        chunk->failed = true;
+        return;
+    }
+
+    jmp_buf recover;
+    lexer->recover = &recover;
+    if(setjmp(recover) == 0) {
+        lexer->offset = chunk->begin;
+        if(chunk->begin == 0)
+            lexer_skip_bom(lexer);
+        while(lexer->offset < chunk->end && lexer_lex_step(lexer))
+            ;
+        chunk->stop = lexer->offset;
+    } else {
+        chunk->failed = true;
+    }
+    lexer->recover = null;
+}
+
+#if defined(CORETEN_OS_WINDOWS)
+static DWORD WINAPI lexer_chunk_thread(LPVOID chunk) {
+    lexer_lex_chunk(cast(LexerChunk*)chunk);
+    return 0;
+}
+#else
+static void* lexer_chunk_thread(void* chunk) {
+    lexer_lex_chunk(cast(LexerChunk*)chunk);
+    return null;
+}
+#endif // CORETEN_OS_WINDOWS
+
+// Append the decoded STRINGs and integer literals of `from` that begin after `offset` to `lexer`
+static inline void lexer_append_strings(Lexer* lexer, Lexer* from, UInt32 offset) {
+    for(UInt32 i = lexer_find_string(from, offset); i < from->num_escaped; i++)
+        lexer_push_string(lexer, from->escaped[i]);
+    for(UInt32 i = lexer_find_int(from, offset); i < from->num_ints; i++)
+        lexer_push_int(lexer, from->ints[i]);
+}
+
+// Append the trivia of `from` that precedes its tokens from `begin` on to `lexer`, where token `begin` of `from` is
+// token `index` of `lexer`
+static inline void lexer_append_trivia_from(Lexer* lexer, Lexer* from, TokenIndex begin, TokenIndex index) {
+    for(UInt32 i = lexer_find_trivia(from, begin); i < from->num_trivia; i++) {
+        LexerTrivia trivia = from->trivia[i];
+        trivia.token = trivia.token - begin + index;
+        lexer_append_trivia(lexer, trivia);
+    }
+}
+
+// Append the tokens [begin, with->size) of `with` to `list`
+static inline void lexer_append_tokens(TokenList* list, TokenList* with, TokenIndex begin) {
+    for(TokenIndex i = begin; i < with->size; i++)
+        tokenlist_push(list, cast(TokenKind)with->kinds[i], with->offsets[i], with->lens[i], with->atoms[i]);
+}
+
+// Intern the names of `lexer->toklist` in order, so that the Atoms are the same as `lexer_lex()` would have created.
+// A MACRO is a name only if it follows an `@` (otherwise it is the `macro` keyword).
+static void lexer_intern_names(Lexer* lexer) {
+    TokenList* list = lexer->toklist;
+    const char* data = lexer->buffer->data;
+    for(TokenIndex i = 0; i < list->size; i++) {
+        if(list->kinds[i] == IDENTIFIER ||
+           (list->kinds[i] == MACRO && list->offsets[i] > 0 && data[list->offsets[i] - 1] == '@'))
+            list->atoms[i] = lexer_intern(lexer, list->offsets[i], list->lens[i]);
+    }
+}
+
+// Lex the Source files on `num_threads` threads
+void lexer_lex_parallel(Lexer* lexer, UInt32 num_threads) {
+    UInt32 len = cast(UInt32)buff_len(lexer->buffer);
+    UInt32 num_chunks = len / LEXER_PARALLEL_MIN_CHUNK;
+    if(num_chunks > num_threads)
+        num_chunks = num_threads;
+    if(num_chunks <= 1) {
+        lexer_lex(lexer);
+        return;
+    }
+
+    // Split the Lexical buffer at the first newline after every `len / num_chunks` Bytes
+    LexerChunk* chunks = cast(LexerChunk*)calloc(num_chunks, sizeof(LexerChunk));
+    CORETEN_ENFORCE_NN(chunks, "Could not allocate memory. Memory full.");
+    UInt32 count = 0;
+    UInt32 begin = 0;
+    for(UInt32 i = 1; i <= num_chunks && begin < len; i++) {
+        UInt32 end = len;
+        if(i < num_chunks) {
+            UInt32 target = cast(UInt32)((cast(UInt64)len * i) / num_chunks);
+            if(target < begin)
+                target = begin;
+            char* newline = cast(char*)memchr(lexer->buffer->data + target, '\n', len - target);
+            end = newline ? cast(UInt32)(newline - lexer->buffer->data) + 1 : len;
+        }
+
+        LexerChunk* chunk = &chunks[count++];
+        chunk->lexer = cast(Lexer*)calloc(1, sizeof(Lexer));
+        CORETEN_ENFORCE_NN(chunk->lexer, "Could not allocate memory. Memory full.");
+        chunk->lexer->buffer = lexer->buffer;
+        chunk->lexer->trivia_mode = lexer->trivia_mode;
+        chunk->lexer->decode_ints = lexer->decode_ints;
+        chunk->lexer->toklist = tokenlist_new(lexer_token_capacity(lexer->buffer->data + begin, end - begin));
+        chunk->begin = begin;
+        chunk->end = end;
+        begin = end;
+    }
+
+    // The first chunk is lexed on this thread
+#if defined(CORETEN_OS_WINDOWS)
+    HANDLE* threads = cast(HANDLE*)calloc(count, sizeof(HANDLE));
+    CORETEN_ENFORCE_NN(threads, "Could not allocate memory. Memory full.");
+    for(UInt32 i = 1; i < count; i++) {
+        threads[i] = CreateThread(null, 0, lexer_chunk_thread, &chunks[i], 0, null);
+        CORETEN_ENFORCE_NN(threads[i], "Could not create a Lexer thread");
+    }
+    lexer_lex_chunk(&chunks[0]);
+    for(UInt32 i = 1; i < count; i++) {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+    }
+#else
+    pthread_t* threads = cast(pthread_t*)calloc(count, sizeof(pthread_t));
+    CORETEN_ENFORCE_NN(threads, "Could not allocate memory. Memory full.");
+    for(UInt32 i = 1; i < count; i++)
+        CORETEN_ENFORCE(pthread_create(&threads[i], null, lexer_chunk_thread, &chunks[i]) == 0,
+                        "Could not create a Lexer thread");
+    lexer_lex_chunk(&chunks[0]);
+    for(UInt32 i = 1; i < count; i++)
+        pthread_join(threads[i], null);
+#endif // CORETEN_OS_WINDOWS
+    free(threads);
+
+    // Like `lexer_lex()`, report invalid UTF-8 before anything else
+    for(UInt32 i = 0; i < count; i++) {
+        if(chunks[i].begin + chunks[i].valid < chunks[i].end) {
+            lexer->offset = chunks[i].begin + chunks[i].valid;
+            lexer_error(lexer, ErrorInvalidCharacter, "Invalid UTF-8 sequence");
+        }
+    }
+
+    // Stitch the chunks together. `lexer->offset` is where the previous chunk actually ended.
+    // Names are interned once the tokens are stitched together (see below)
+    Interner* interner = lexer->interner;
+    lexer->interner = null;
+    lexer->offset = 0;
+    for(UInt32 i = 0; i < count; i++) {
+        LexerChunk* chunk = &chunks[i];
+        TokenList* speculative = chunk->lexer->toklist;
+        if(!chunk->failed && lexer->offset == chunk->begin) {
+            lexer_append_trivia_from(lexer, chunk->lexer, 0, lexer->toklist->size);
+            tokenlist_splice(lexer->toklist, lexer->toklist->size, lexer->toklist->size, speculative, 0);
+            lexer_append_strings(lexer, chunk->lexer, 0);
+            lexer->nest_level += chunk->lexer->nest_level;
+            lexer->offset = chunk->stop;
+            continue;
+        }
+        if(lexer->offset >= chunk->end)
+            continue;
+
+        // The guess was wrong: relex sequentially until a token lines up with a speculative one. The tokens of a
+        // failed chunk can't be trusted, so it is relexed in full (reporting the error, if it is real)
+        if(lexer->offset == 0)
+            lexer_skip_bom(lexer);
+        TokenIndex j = 0;
+        bool resynced = false;
+        while(!resynced && lexer->offset < chunk->end) {
+            UInt32 size = lexer->toklist->size;
+            if(!lexer_lex_step(lexer))
                 break;
-        } // switch(ch)
+            if(chunk->failed || lexer->toklist->size == size)
+                continue;
+
+            UInt32 last = lexer->toklist->size - 1;
+            UInt32 offset = lexer->toklist->offsets[last];
+            while(j < speculative->size && speculative->offsets[j] < offset)
+                j++;
+            if(j < speculative->size && speculative->offsets[j] == offset &&
+               speculative->kinds[j] == lexer->toklist->kinds[last] && speculative->lens[j] == lexer->toklist->lens[last]) {
+                lexer_append_trivia_from(lexer, chunk->lexer, j + 1, lexer->toklist->size);
+                lexer_append_tokens(lexer->toklist, speculative, j + 1);
+                lexer_append_strings(lexer, chunk->lexer, offset + 1);
+                lexer->nest_level += lexer_nesting(speculative, j + 1, speculative->size);
+                lexer->offset = chunk->stop;
+                resynced = true;
+            }
+        }
+    }
 
-        if(tokenkind == TOK_NULL) continue;
-        lexer_maketoken(lexer, tokenkind, buff_new(null), lexer->offset - 1, lexer->loc->line, lexer->loc->col - 1);
-    } // while
+    // The decoded STRINGs that were kept point into the chunks' arenas
+    for(UInt32 i = 0; i < count; i++) {
+        if(chunks[i].lexer->strings) {
+            if(!lexer->strings)
+                lexer->strings = arena_new(ARENA_DEFAULT_BLOCK_SIZE);
+            arena_merge(lexer->strings, chunks[i].lexer->strings);
+        }
+        tokenlist_free(chunks[i].lexer->toklist);
+        free(chunks[i].lexer->escaped);
+        free(chunks[i].lexer->ints);
+        free(chunks[i].lexer->trivia);
+        free(chunks[i].lexer);
+    }
+    free(chunks);
+
+    // The chunks were lexed without an Interner (it isn't thread-safe), so the names are interned here
+    lexer->interner = interner;
+    lexer_intern_names(lexer);
+
+    lexer_maketoken(lexer, TOK_EOF, lexer->offset, 0);
+}
 
-lex_eof:;
+// ---------------------------------------------------------------------------------------------------------------
+// Token cache
+// ---------------------------------------------------------------------------------------------------------------
+// A token cache (`<dir>/<hash>.adtok`) holds everything `lexer_lex()` leaves behind for a Lexical buffer, keyed by the
+// hash of its contents, so an unchanged file is loaded with a single mapping of its cache (and a few copies) instead
+// of being relexed. Its layout, in native byte order (a cache isn't meant to be moved across machines):
+//      LexerCacheHeader
+//      UInt32 offsets[num_tokens], lens[num_tokens]
+//      UInt32 line_starts[num_lines]
+//      UInt32 escaped[num_escaped][2]      (offset and decoded length of each STRING with escape sequences)
+//      UInt32 trivia[num_trivia][4]        (token, offset, length and TriviaKind of each trivia)
+//      UInt8 kinds[num_tokens]
+//      char values[values_len]             (the decoded STRINGs, each followed by a `\0`)
+// Atoms aren't stored - they only mean something to the Interner that created them.
+
+#define LEXER_CACHE_MAGIC       0x4b544441  // "ADTK"
+
+typedef struct LexerCacheHeader {
+    UInt32 magic;       // LEXER_CACHE_MAGIC (this also rejects caches written with the other byte order)
+    UInt32 version;     // LEXER_CACHE_VERSION
+    UInt64 hash;        // hash of the Lexical buffer
+    UInt64 source_len;  // length of the Lexical buffer
+    UInt32 num_kinds;   // TOK_COUNT (the cache is stale once TokenKinds are added or removed)
+    UInt32 num_tokens;
+    UInt32 num_lines;
+    UInt32 num_escaped;
+    UInt32 values_len;
+    UInt32 offset;      // `lexer->offset` once lexed
+    Int32 nest_level;   // `lexer->nest_level` once lexed
+    UInt32 trivia_mode; // the LexerTriviaMode the buffer was lexed with
+    UInt32 num_trivia;
+    UInt32 reserved;
+} LexerCacheHeader;
+
+// Size of a cache (in Bytes)
+static inline UInt64 lexer_cache_size(const LexerCacheHeader* header) {
+    return sizeof(LexerCacheHeader) +
+           sizeof(UInt32) * (2 * cast(UInt64)header->num_tokens + header->num_lines + 2 * cast(UInt64)header->num_escaped +
+                             4 * cast(UInt64)header->num_trivia) +
+           header->num_tokens + header->values_len;
+}
+
+// Path of the cache of a Lexical buffer whose hash is `hash`. The result must be freed
+static char* lexer_cache_path(const char* dir, UInt64 hash, const char* suffix) {
+    Ll len = strlen(dir) + strlen(suffix) + 32;
+    char* path = cast(char*)malloc(len);
+    CORETEN_ENFORCE_NN(path, "Could not allocate memory. Memory full.");
+    snprintf(path, len, "%s/%016llx.adtok%s", dir, cast(unsigned long long)hash, suffix);
+    return path;
+}
+
+bool lexer_cache_save(Lexer* lexer, const char* dir) {
+    TokenList* list = lexer->toklist;
+    // Only a Lexer that has been lexed in full can be cached
+    if(list->mask != TOKENLIST_NO_MASK || list->size == 0 || list->kinds[list->size - 1] != TOK_EOF)
+        return false;
+    if(!lexer->line_starts)
+        lexer_index_lines(lexer);
+
+    LexerCacheHeader header = {0};
+    header.magic = LEXER_CACHE_MAGIC;
+    header.version = LEXER_CACHE_VERSION;
+    header.source_len = buff_len(lexer->buffer);
+    header.hash = hash_murmur64(lexer->buffer->data, cast(Ll)header.source_len);
+    header.num_kinds = TOK_COUNT;
+    header.num_tokens = list->size;
+    header.num_lines = lexer->num_lines;
+    header.num_escaped = lexer->num_escaped;
+    for(UInt32 i = 0; i < lexer->num_escaped; i++)
+        header.values_len += lexer->escaped[i].len + 1;
+    header.offset = lexer->offset;
+    header.nest_level = lexer->nest_level;
+    header.trivia_mode = lexer->trivia_mode;
+    header.num_trivia = lexer->num_trivia;
+
+    // The cache is written under a name of its own and then renamed, so `lexer_cache_load()` never sees a partially
+    // written cache (even if several processes write the same one at once)
+    char suffix[32];
+#if defined(CORETEN_OS_WINDOWS)
+    snprintf(suffix, sizeof(suffix), ".%lu.tmp", cast(unsigned long)GetCurrentProcessId());
+#else
+    snprintf(suffix, sizeof(suffix), ".%ld.tmp", cast(long)getpid());
+#endif // CORETEN_OS_WINDOWS
+    char* temp = lexer_cache_path(dir, header.hash, suffix);
+    FILE* file = fopen(temp, "wb");
+    if(!file) {
+        free(temp);
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(list->offsets, sizeof(UInt32), list->size, file) == list->size &&
+              fwrite(list->lens, sizeof(UInt32), list->size, file) == list->size &&
+              fwrite(lexer->line_starts, sizeof(UInt32), lexer->num_lines, file) == lexer->num_lines;
+    for(UInt32 i = 0; ok && i < lexer->num_escaped; i++) {
+        UInt32 entry[2] = { lexer->escaped[i].offset, lexer->escaped[i].len };
+        ok = fwrite(entry, sizeof(UInt32), 2, file) == 2;
+    }
+    for(UInt32 i = 0; ok && i < lexer->num_trivia; i++) {
+        LexerTrivia* trivia = &lexer->trivia[i];
+        UInt32 entry[4] = { trivia->token, trivia->offset, trivia->len, trivia->kind };
+        ok = fwrite(entry, sizeof(UInt32), 4, file) == 4;
+    }
+    ok = ok && fwrite(list->kinds, sizeof(UInt8), list->size, file) == list->size;
+    for(UInt32 i = 0; ok && i < lexer->num_escaped; i++)
+        ok = fwrite(lexer->escaped[i].value, 1, lexer->escaped[i].len + 1, file) == lexer->escaped[i].len + 1;
+    ok = fclose(file) == 0 && ok;
+
+    char* path = lexer_cache_path(dir, header.hash, "");
+#if defined(CORETEN_OS_WINDOWS)
+    ok = ok && MoveFileExA(temp, path, MOVEFILE_REPLACE_EXISTING);
+#else
+    ok = ok && rename(temp, path) == 0;
+#endif // CORETEN_OS_WINDOWS
+    if(!ok)
+        remove(temp);
+    free(temp);
+    free(path);
+    return ok;
+}
+
+bool lexer_cache_load(Lexer* lexer, const char* dir) {
+    if(lexer->toklist->mask != TOKENLIST_NO_MASK || lexer->toklist->size > 0)
+        return false;
+
+    UInt64 source_len = buff_len(lexer->buffer);
+    UInt64 hash = hash_murmur64(lexer->buffer->data, cast(Ll)source_len);
+    char* path = lexer_cache_path(dir, hash, "");
+    // The cache is optional: a file that's missing, or can't be opened or read, is a miss
+    FileMap* file = file_try_map(path);
+    free(path);
+    if(!file)
+        return false;
+
+    const LexerCacheHeader* header = cast(const LexerCacheHeader*)file->contents;
+    if(file->len < sizeof(LexerCacheHeader) || header->magic != LEXER_CACHE_MAGIC ||
+       header->version != LEXER_CACHE_VERSION || header->hash != hash || header->source_len != source_len ||
+       header->num_kinds != TOK_COUNT || header->trivia_mode != lexer->trivia_mode || header->num_tokens == 0 || lexer_cache_size(header) != file->len) {
+        file_unmap(file);
+        return false;
+    }
+
+    // The sections are laid out back to back (see above). A mapping is page-aligned, so every section is aligned.
+    UInt32 num_tokens = header->num_tokens;
+    const UInt32* offsets = cast(const UInt32*)(header + 1);
+    const UInt32* lens = offsets + num_tokens;
+    const UInt32* line_starts = lens + num_tokens;
+    const UInt32* escaped = line_starts + header->num_lines;
+    const UInt32* trivia = escaped + 2 * header->num_escaped;
+    const UInt8* kinds = cast(const UInt8*)(trivia + 4 * header->num_trivia);
+    const char* values = cast(const char*)(kinds + num_tokens);
+
+    TokenList* list = lexer->toklist;
+    if(list->cap < num_tokens) {
+        tokenlist_free(list);
+        list = lexer->toklist = tokenlist_new(num_tokens);
+    }
+    memcpy(list->kinds, kinds, num_tokens * sizeof(UInt8));
+    memcpy(list->offsets, offsets, num_tokens * sizeof(UInt32));
+    memcpy(list->lens, lens, num_tokens * sizeof(UInt32));
+    memset(list->atoms, 0, num_tokens * sizeof(Atom));
+    list->size = num_tokens;
+
+    lexer_drop_lines(lexer);
+    lexer->line_starts = cast(UInt32*)malloc(header->num_lines * sizeof(UInt32));
+    CORETEN_ENFORCE_NN(lexer->line_starts, "Could not allocate memory. Memory full.");
+    memcpy(lexer->line_starts, line_starts, header->num_lines * sizeof(UInt32));
+    lexer->num_lines = header->num_lines;
+
+    if(header->num_escaped > 0) {
+        if(!lexer->strings)
+            lexer->strings = arena_new(ARENA_DEFAULT_BLOCK_SIZE);
+        char* value = cast(char*)arena_alloc(lexer->strings, header->values_len, 1);
+        memcpy(value, values, header->values_len);
+        for(UInt32 i = 0; i < header->num_escaped; i++) {
+            LexerString string = { escaped[2 * i], escaped[2 * i + 1], value };
+            lexer_push_string(lexer, string);
+            value += string.len + 1;
+        }
+    }
+
+    lexer->num_trivia = 0;
+    for(UInt32 i = 0; i < header->num_trivia; i++) {
+        const UInt32* entry = trivia + 4 * i;
+        LexerTrivia t = { entry[0], entry[1], entry[2], cast(UInt8)entry[3] };
+        lexer_append_trivia(lexer, t);
+    }
+
+    lexer->offset = header->offset;
+    lexer->nest_level = header->nest_level;
+    file_unmap(file);
+
+    // Decoded integer literals aren't cached (they are cheap to decode, and not every Lexer wants them)
+    lexer->num_ints = 0;
+    if(lexer->decode_ints) {
+        for(TokenIndex i = 0; i < num_tokens; i++) {
+            if(lexer_is_int(cast(TokenKind)list->kinds[i]))
+                lexer_decode_int(lexer, cast(TokenKind)list->kinds[i], list->offsets[i], list->offsets[i] + list->lens[i]);
+        }
+    }
 
-    lexer_maketoken(lexer, TOK_EOF, buff_new(null), lexer->offset - 1, lexer->loc->line, lexer->loc->col - 1);
+    lexer_intern_names(lexer);
+    return true;
 }
@@ -13,14 +13,20 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 #ifndef ADORAD_LEXER_H
 #define ADORAD_LEXER_H
 
+#include <setjmp.h>
+
 #include <adorad/core/misc.h>
 #include <adorad/core/types.h>
 #include <adorad/core/char.h> 
 #include <adorad/core/vector.h>
 #include <adorad/core/buffer.h>
+#include <adorad/core/arena.h>
+#include <adorad/core/io.h>
+#include <adorad/core/utf8.h>
 #include <adorad/core/debug.h>
 
 #include <adorad/compiler/tokens.h>
+#include <adorad/compiler/interner.h>
 #include <adorad/compiler/location.h>
 #include <adorad/compiler/error.h>
 
@@ -28,7 +34,8 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
     Adorad's Lexer is built in such a way that no (or negligible) memory allocations are necessary during usage. 
 
     In order to be able to not allocate any memory during tokenization, STRINGs and NUMBERs are just sanity checked
-    but _not_ converted - it is the Parser's responsibility to perform the right conversion.
+    but _not_ converted - it is the Parser's responsibility to perform the right conversion. The exceptions are STRINGs
+    with escape sequences, and integer literals if `lexer_set_decode_ints()` asks for them.
 
     In case of a scan error, ILLEGAL is returned and the error details can be extracted from the token itself.
 
@@ -36,30 +43,133 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
         1. ASCII Table: http://www.theasciicode.com.ar 
 */
 
-// This macro defines how many tokens we initially expect in lexer->toklist. 
-// When this limit is reached, we realloc using this same constant (TOKENLIST_ALLOC_CAPACITY * sizeof(Token)) bytes 
-// at a time (which works out to around 0.26MB) per (re)allocation
+// This macro defines how many tokens we initially expect in lexer->toklist (at least - it is presized from an estimate
+// of the number of tokens in the Lexical buffer). When this limit is reached, the capacity of lexer->toklist is
+// doubled (each token costs 13 bytes)
 #define TOKENLIST_ALLOC_CAPACITY    8192
+// Default number of tokens held by a streaming Lexer (see `lexer_init_streaming()`). This bounds how far the Parser
+// can look ahead or put back.
+#define TOKENLIST_STREAM_WINDOW     256
+// `lexer_lex_parallel()` doesn't split the Lexical buffer into chunks smaller than this (in Bytes)
+#define LEXER_PARALLEL_MIN_CHUNK    (64 * 1024)
+// Version of the token cache format (see `lexer_cache_save()`). Bump this whenever the format or the meaning of a
+// TokenKind changes.
+#define LEXER_CACHE_VERSION         2
 // Maximum length of an individual token
 #define MAX_TOKEN_LENGTH            256
 
+// A STRING whose value isn't its source text (because it contains escape sequences). The decoded value lives in the
+// Lexer's string arena.
+typedef struct LexerString {
+    UInt32 offset;      // offset of the STRING token
+    UInt32 len;         // length of the decoded value
+    char* value;        // the decoded value (NUL-terminated)
+} LexerString;
+
+// The value of an integer literal (INTEGER, HEX_INT, BIN_INT or OCT_INT), decoded while lexing (see
+// `lexer_set_decode_ints()`). Literals are unsigned (`-` is a token of its own) and hold up to 128 bits.
+typedef struct LexerInt {
+    UInt32 offset;      // offset of the token
+    bool overflow;      // set if the value doesn't fit in 128 bits (`lo` and `hi` are then meaningless)
+    UInt64 lo;          // low 64 bits of the value
+    UInt64 hi;          // high 64 bits of the value
+} LexerInt;
+
+// What the Lexer records as trivia (see `lexer_set_trivia()`)
+typedef enum LexerTriviaMode {
+    LEXER_TRIVIA_NONE = 0,  // line comments are COMMENT tokens, and block comments and whitespace are dropped
+    LEXER_TRIVIA_COMMENTS,  // comments are kept out of the token stream, in `lexer->trivia`
+    LEXER_TRIVIA_ALL        // as are whitespace runs (the tokens and the trivia then cover the entire Lexical buffer)
+} LexerTriviaMode;
+
+typedef enum TriviaKind {
+    TRIVIA_WHITESPACE = 0,
+    TRIVIA_LINE_COMMENT,    // `// ...`, `# ...` or a shebang (without the newline)
+    TRIVIA_BLOCK_COMMENT    // `/* ... */`
+} TriviaKind;
+
+// Source text between two tokens that doesn't affect the meaning of the program
+typedef struct LexerTrivia {
+    TokenIndex token;   // index of the token that follows the trivia
+    UInt32 offset;      // offset of the trivia (comment markers included)
+    UInt32 len;         // length of the trivia (in Bytes)
+    UInt8 kind;         // TriviaKind
+} LexerTrivia;
+
 typedef struct Lexer {
     Buff* buffer;       // the Lexical buffer
     UInt32 offset;      // current buffer offset (in Bytes) 
                         // offset of the curr char (no. of chars b/w the beginning of the Lexical Buffer
                         // and the curr char)
 
-    Vec* toklist;       // list of tokens
-    Location* loc;      // location of the token in the source code
+    TokenList* toklist; // list of tokens
+    Location* loc;      // source file of the Lexical buffer (line/col are computed on demand by `lexer_location()`)
+    UInt32* line_starts;// offset at which each line begins (built by the first call to `lexer_location()`)
+    UInt32 num_lines;   // number of entries in `line_starts`
+    Arena* strings;     // decoded values of STRINGs with escape sequences (created on first use)
+    LexerString* escaped;   // the STRINGs with escape sequences, sorted by offset (see `lexer_string_value()`)
+    UInt32 num_escaped; // number of entries in `escaped`
+    UInt32 cap_escaped; // capacity of `escaped`
+    LexerInt* ints;     // the decoded integer literals, sorted by offset (see `lexer_int_value()`)
+    UInt32 num_ints;    // number of entries in `ints`
+    UInt32 cap_ints;    // capacity of `ints`
+    bool decode_ints;   // set by `lexer_set_decode_ints()`
+    LexerTrivia* trivia;// the trivia recorded so far, sorted by token (see `lexer_token_trivia()`)
+    UInt32 num_trivia;  // number of entries in `trivia`
+    UInt32 cap_trivia;  // capacity of `trivia`
+    UInt8 trivia_mode;  // LexerTriviaMode (LEXER_TRIVIA_NONE unless set by `lexer_set_trivia()`)
 
     bool is_inside_str; // set to true inside a string
     int nest_level;     // used to infer if we're inside many `{}`s
+    bool owns_buffer;   // set once `lexer_relex()` has replaced the caller's buffer with one we allocated
+    Interner* interner; // Atoms of the IDENTIFIERs and MACROs (see `lexer_use_interner()`)
+    bool owns_interner; // set unless the Interner is shared with other Lexers
+    jmp_buf* recover;   // if set, `lexer_error()` jumps here instead of exiting (used when lexing speculatively)
 } Lexer;
 
 Lexer* lexer_init(char* buffer, const char* fname);
-static void lexer_free(Lexer* lexer);
+// Create a Lexer over a file mapped into memory by `file_map()` (the file must outlive the Lexer)
+Lexer* lexer_init_mapped(FileMap* file, const char* fname);
+// Create a streaming Lexer: tokens are lexed on demand by `lexer_next_token()`, and only the last `window` of them
+// are kept in `lexer->toklist`
+Lexer* lexer_init_streaming(char* buffer, const char* fname, UInt32 window);
+void lexer_free(Lexer* lexer);
+// Intern the names of this Lexer into `interner` (shared by every file of a compilation) instead of its own Interner
+void lexer_use_interner(Lexer* lexer, Interner* interner);
+// Decode integer literals while lexing, so that their values don't need to be parsed again. Must be called before
+// lexing
+void lexer_set_decode_ints(Lexer* lexer, bool decode);
+// Returns the decoded value of an integer literal, or null unless integer literals are decoded
+const LexerInt* lexer_int_value(Lexer* lexer, Token* token);
+// Record comments (and whitespace, if `mode` is LEXER_TRIVIA_ALL) as trivia, keeping them out of the token stream.
+// Must be called before lexing
+void lexer_set_trivia(Lexer* lexer, LexerTriviaMode mode);
+// Returns the trivia that precedes `token`, and stores their number in `count`
+const LexerTrivia* lexer_token_trivia(Lexer* lexer, TokenIndex token, UInt32* count);
 void lexer_error(Lexer* lexer, Error e, const char* format, ...);
+// Returns an owned copy of a token's value (tokens are views into `lexer->buffer`)
+Buff* lexer_token_value(Lexer* lexer, Token* token);
+// Returns the value of a STRING token (its escape sequences decoded) and stores its length in `len`. This is a view
+// into the Lexical buffer unless the STRING contains escape sequences, and is only NUL-terminated in that case.
+const char* lexer_string_value(Lexer* lexer, Token* token, UInt32* len);
+// Returns the location (line, col) of `offset` in the Lexical buffer (a binary search over `lexer->line_starts`)
+Location lexer_location(Lexer* lexer, UInt32 offset);
 // Lex the source files
-static void lexer_lex(Lexer* lexer);
+void lexer_lex(Lexer* lexer);
+// Lex the source files, splitting the Lexical buffer across `num_threads` threads. The tokens are identical to the
+// ones `lexer_lex()` produces
+void lexer_lex_parallel(Lexer* lexer, UInt32 num_threads);
+// Lex the next token and return its index in `lexer->toklist`. Once the end of the buffer is reached, this keeps
+// returning the index of the EOF token
+TokenIndex lexer_next_token(Lexer* lexer);
+// Apply an edit to the Lexical buffer (replace `removed_len` bytes at `edit_offset` with `inserted_text`) and relex
+// only the tokens affected by it
+void lexer_relex(Lexer* lexer, UInt32 edit_offset, UInt32 removed_len, const char* inserted_text);
+// Write the tokens of `lexer` (lexed in full) to a token cache in `dir`, keyed by the hash of the Lexical buffer.
+// Returns false if the cache couldn't be written
+bool lexer_cache_save(Lexer* lexer, const char* dir);
+// Load the tokens of `lexer` (not lexed yet) from a token cache in `dir` in place of `lexer_lex()`. Returns false,
+// leaving the Lexer untouched, if `dir` holds no cache of the Lexical buffer
+bool lexer_cache_load(Lexer* lexer, const char* dir);
 
 #endif // ADORAD_LEXER_H
\ No newline at end of file
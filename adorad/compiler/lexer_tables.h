@@ -0,0 +1,219 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+
+// Auto-generated by tools/scripts/generate_tokens.py from `ALLTOKENS` (adorad/compiler/tokens.h). Do not edit.
+// Regenerate with: python3 tools/scripts/generate_tokens.py lexer_tables
+// NB: This is only meant to be included by `lexer.c`
+#ifndef ADORAD_LEXER_TABLES_H
+#define ADORAD_LEXER_TABLES_H
+
+#define KEYWORD_MIN_LENGTH      2
+#define KEYWORD_MAX_LENGTH      11
+
+// Perfect hash over (first char, second char, third char, last char, length) of a keyword candidate
+// `value` must have at least KEYWORD_MIN_LENGTH (2) characters
+#define KEYWORD_HASH_MULT       0xEF4D7AD1U
+#define KEYWORD_HASH_BITS       7
+#define KEYWORD_HASH_KEY(value, len)                                                           \
+    (((UInt32)(UInt8)(value)[0] | ((UInt32)(UInt8)(value)[1] << 8) |                            \
+      ((UInt32)(UInt8)(value)[(len) > 2 ? 2 : 1] << 16)) ^                                     \
+     ((UInt32)(UInt8)(value)[(len) - 1] << 24) ^ (UInt32)(len))
+#define KEYWORD_HASH(value, len)    \
+    ((UInt32)(KEYWORD_HASH_KEY(value, len) * KEYWORD_HASH_MULT) >> (32 - KEYWORD_HASH_BITS))
+
+// Keyword TokenKind in each hash slot (TOK_NULL if the slot is empty)
+static const UInt8 keywordSlotKinds[128] = {
+    TOK_NULL,  FINALLY,   USE,       TOK_NULL,  TOK_NULL,  TOK_NULL,  MODULE,    EXCEPT,
+    INCLUDE,   TOK_NULL,  ENUM,      TOK_NULL,  IF,        TOK_NULL,  TOK_NULL,  TOK_NULL,
+    MATCH,     TOK_NULL,  TOK_NULL,  TOK_NULL,  ASYNC,     UNION,     TOK_NULL,  IMPORT,
+    TYPEOF,    TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,  TUPLE,     WHEN,      DEFER,
+    TOK_NULL,  CATCH,     CASE,      TOK_NULL,  TOK_NULL,  EXPORT,    TOK_NULL,  TOK_NULL,
+    EXTERN,    INLINE,    TOK_NULL,  TOK_NULL,  FROM,      MAP,       TOK_NULL,  TOK_NULL,
+    TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,  AS,        CONST,     RAISE,     TOK_NULL,
+    TOK_NULL,  TOK_NULL,  RETURN,    ATOMIC,    TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,
+    TYPE,      CAST,      TOK_NULL,  TOK_NULL,  PRAGMA,    TOK_NULL,  TOK_NULL,  TOK_NULL,
+    ORELSE,    TRY,       TOK_NULL,  TOK_NULL,  BREAK,     MUTABLE,   FUNC,      ISA,
+    TOK_NULL,  TOK_NULL,  VOLATILE,  TOK_NULL,  SUSPEND,   TOK_NULL,  ELSEIF,    TOK_NULL,
+    MACRO,     TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,  ANY,       TOK_NULL,
+    TOK_NULL,  TOK_NULL,  FOR,       TOK_NULL,  GLOBAL,    TOK_NULL,  TOK_NULL,  TOK_NULL,
+    DO,        RANGE,     TOK_NULL,  NOT,       CONTINUE,  TOK_NULL,  TOK_NULL,  WHILE,
+    TOK_NULL,  IN,        TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,  TOK_NULL,
+    TOK_NULL,  WHERE,     TOK_NULL,  FALLTHROUGH, DECL,      TOK_NULL,  ELSE,      TOK_NULL,
+};
+
+// Length of the keyword in each hash slot (0 if the slot is empty)
+static const UInt8 keywordSlotLengths[128] = {
+     0,  7,  3,  0,  0,  0,  6,  6,  7,  0,  4,  0,  2,  0,  0,  0,
+     5,  0,  0,  0,  5,  5,  0,  6,  6,  0,  0,  0,  0,  5,  4,  5,
+     0,  5,  4,  0,  0,  6,  0,  0,  6,  6,  0,  0,  4,  3,  0,  0,
+     0,  0,  0,  0,  2,  5,  5,  0,  0,  0,  6,  6,  0,  0,  0,  0,
+     4,  4,  0,  0,  6,  0,  0,  0,  6,  3,  0,  0,  5,  7,  4,  3,
+     0,  0,  8,  0,  7,  0,  6,  0,  5,  0,  0,  0,  0,  0,  3,  0,
+     0,  0,  3,  0,  6,  0,  0,  0,  2,  5,  0,  3,  8,  0,  0,  5,
+     0,  2,  0,  0,  0,  0,  0,  0,  0,  5,  0, 11,  4,  0,  4,  0,
+};
+
+// Operator DFA
+// `lexerCharClass` maps every byte to its character class (0 for bytes that can't appear in an operator).
+// `lexerDfaTransitions[state][class]` is the next state (0 means "stop here"), and `lexerDfaAccept[state]` is the
+// TokenKind emitted when the DFA stops in `state`. State 0 is the start state.
+#define LEXER_DFA_NUM_CLASSES   26
+#define LEXER_DFA_NUM_STATES    56
+
+static const UInt8 lexerCharClass[256] = {
+    ['!'] = 1,
+    ['%'] = 2,
+    ['&'] = 3,
+    ['('] = 4,
+    [')'] = 5,
+    ['*'] = 6,
+    ['+'] = 7,
+    [','] = 8,
+    ['-'] = 9,
+    ['.'] = 10,
+    ['/'] = 11,
+    [':'] = 12,
+    [';'] = 13,
+    ['<'] = 14,
+    ['='] = 15,
+    ['>'] = 16,
+    ['?'] = 17,
+    ['['] = 18,
+    ['\\'] = 19,
+    [']'] = 20,
+    ['^'] = 21,
+    ['{'] = 22,
+    ['|'] = 23,
+    ['}'] = 24,
+    ['~'] = 25,
+};
+
+static const UInt8 lexerDfaTransitions[LEXER_DFA_NUM_STATES][LEXER_DFA_NUM_CLASSES] = {
+    /* start */ {  0,  1,  3,  6, 10, 11, 12, 15, 18, 19, 23, 26, 28, 30, 31, 36, 39, 43, 44, 45, 46, 47, 49, 50, 53, 54 },
+    /* !     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* !=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* %     */ {  0,  0,  4,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  5,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* %%    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* %=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* &     */ {  0,  0,  0,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  8,  0,  0,  0,  0,  0,  9,  0,  0,  0,  0 },
+    /* &&    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* &=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* &^    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* (     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* )     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* *     */ {  0,  0,  0,  0,  0,  0, 13,  0,  0,  0,  0,  0,  0,  0,  0, 14,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* **    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* *=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* +     */ {  0,  0,  0,  0,  0,  0,  0, 16,  0,  0,  0,  0,  0,  0,  0, 17,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ++    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* +=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ,     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* -     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0, 20,  0,  0,  0,  0,  0, 21, 22,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* --    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* -=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ->    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* .     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 24,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ..    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 25,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ...   */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* /     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 27,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* /=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* :     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ::    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ;     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* <     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0, 32,  0,  0,  0,  0, 33, 35,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* <-    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* <<    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 34,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* <<=   */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* <=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* =     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 37, 38,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ==    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* =>    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* >     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40, 41,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* >=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* >>    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 42,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* >>=   */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ?     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* [     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* \     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ]     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ^     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 48,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ^=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* {     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* |     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 51,  0,  0,  0,  0,  0,  0,  0, 52,  0,  0 },
+    /* |=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ||    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* }     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ~     */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 55,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+    /* ~=    */ {  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+};
+
+static const UInt8 lexerDfaAccept[LEXER_DFA_NUM_STATES] = {
+    /* start */ TOK_NULL,
+    /* !     */ EXCLAMATION,
+    /* !=    */ EXCLAMATION_EQUALS,
+    /* %     */ MOD,
+    /* %%    */ MOD_MOD,
+    /* %=    */ MOD_EQUALS,
+    /* &     */ AND,
+    /* &&    */ AND_AND,
+    /* &=    */ AND_EQUALS,
+    /* &^    */ AND_NOT,
+    /* (     */ LPAREN,
+    /* )     */ RPAREN,
+    /* *     */ MULT,
+    /* **    */ MULT_MULT,
+    /* *=    */ MULT_EQUALS,
+    /* +     */ PLUS,
+    /* ++    */ PLUS_PLUS,
+    /* +=    */ PLUS_EQUALS,
+    /* ,     */ COMMA,
+    /* -     */ MINUS,
+    /* --    */ MINUS_MINUS,
+    /* -=    */ MINUS_EQUALS,
+    /* ->    */ RARROW,
+    /* .     */ DOT,
+    /* ..    */ DDOT,
+    /* ...   */ ELLIPSIS,
+    /* /     */ SLASH,
+    /* /=    */ SLASH_EQUALS,
+    /* :     */ COLON,
+    /* ::    */ COLON_COLON,
+    /* ;     */ SEMICOLON,
+    /* <     */ LESS_THAN,
+    /* <-    */ LARROW,
+    /* <<    */ LBITSHIFT,
+    /* <<=   */ LBITSHIFT_EQUALS,
+    /* <=    */ LESS_THAN_OR_EQUAL_TO,
+    /* =     */ EQUALS,
+    /* ==    */ EQUALS_EQUALS,
+    /* =>    */ EQUALS_ARROW,
+    /* >     */ GREATER_THAN,
+    /* >=    */ GREATER_THAN_OR_EQUAL_TO,
+    /* >>    */ RBITSHIFT,
+    /* >>=   */ RBITSHIFT_EQUALS,
+    /* ?     */ QUESTION,
+    /* [     */ LSQUAREBRACK,
+    /* \     */ BACKSLASH,
+    /* ]     */ RSQUAREBRACK,
+    /* ^     */ XOR,
+    /* ^=    */ XOR_EQUALS,
+    /* {     */ LBRACE,
+    /* |     */ OR,
+    /* |=    */ OR_EQUALS,
+    /* ||    */ OR_OR,
+    /* }     */ RBRACE,
+    /* ~     */ TILDA,
+    /* ~=    */ TILDA_EQUALS,
+};
+
+#endif // ADORAD_LEXER_TABLES_H
@@ -11,14 +11,17 @@ SPDX-License-Identifier: MIT
 Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 */
 
+#include <stdarg.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <adorad/compiler/parser.h>
 #include <adorad/core/debug.h>
 #include <adorad/core/vector.h>
 
 // Shortcut to `parser->toklist`
 #define pt  parser->toklist
-#define ast_error(...)              panic(ErrorParseError, __VA_ARGS__)
+#define ast_error(...)              parser_error(parser, ErrorParseError, __VA_ARGS__)
 #define parser_chomp_if(kind)       chomp_if(parser, kind)
 #define parser_expect_token(kind)   expect_token(parser, kind)
 
@@ -27,56 +30,241 @@ Parser* parser_init(Lexer* lexer) {
     Parser* parser = cast(Parser*)calloc(1, sizeof(Parser));
     parser->lexer = lexer;
     parser->toklist = lexer->toklist;
-    parser->curr_tok = cast(Token*)vec_at(parser->toklist, 0);
-    parser->num_tokens = vec_size(parser->toklist);
+    parser->iter = tokeniter_new(parser->toklist);
+    parser->num_tokens = parser->toklist->size;
     parser->num_lines = 0;
     parser->mod_name = null;
+    parser->arena = arena_new(ARENA_DEFAULT_BLOCK_SIZE);
     return parser;
 }
 
-inline Token* parser_peek_token(Parser* parser) {
-    return parser->curr_tok;
+void parser_free(Parser* parser) {
+    if(!parser)
+        return;
+    arena_free(parser->arena);
+    free(parser);
+}
+
+void parser_error(Parser* parser, Error err, const char* format, ...) {
+    if(parser->recover)
+        longjmp(*parser->recover, 1);
+
+    char message[256];
+    va_list vl;
+    va_start(vl, format);
+    vsnprintf(message, sizeof(message), format, vl);
+    va_end(vl);
+    panic(err, "%s", message);
+}
+
+void parser_set_lazy_bodies(Parser* parser, bool lazy) {
+    parser->lazy_bodies = lazy;
+}
+
+// Returns the kind of the token at `index`
+inline TokenKind parser_token_kind(Parser* parser, TokenIndex index) {
+    return cast(TokenKind)pt->kinds[TOKENLIST_SLOT(pt, index)];
+}
+
+// Make sure the token `n` tokens ahead of the current one has been lexed.
+// A streaming Lexer (see `lexer_init_streaming()`) only lexes tokens as they are needed. For a fully lexed
+// `lexer->toklist` this is a no-op.
+inline void parser_fill(Parser* parser, UInt32 n) {
+    while(pt->size <= parser->iter.index + n) {
+        if(pt->size > 0 && pt->kinds[TOKENLIST_SLOT(pt, pt->size - 1)] == TOK_EOF)
+            break;
+        lexer_next_token(parser->lexer);
+    }
+}
+
+// Returns a copy of the value of the token at `index`. Like the nodes that hold it, the copy lives in
+// `parser->arena` (so names in the AST are freed along with it)
+Buff* parser_token_value(Parser* parser, TokenIndex index) {
+    Token token = tokenlist_at(pt, index);
+    const char* source = parser->lexer->buffer->data + token.offset;
+    UInt32 len = token.len;
+    if(token.kind == STRING)
+        source = lexer_string_value(parser->lexer, &token, &len);
+
+    char* value = cast(char*)arena_alloc(parser->arena, len + 1, 1);
+    memcpy(value, source, len);
+    value[len] = nullchar;
+
+    Buff* out = cast(Buff*)arena_alloc(parser->arena, sizeof(Buff), sizeof(UInt64));
+    out->data = value;
+    out->len = len;
+    out->is_utf8 = false;
+    return out;
+}
+
+inline TokenIndex parser_peek_token(Parser* parser) {
+    parser_fill(parser, 0);
+    return parser->iter.index;
+}
+
+// Returns the kind of the current token
+inline TokenKind parser_peek_kind(Parser* parser) {
+    parser_fill(parser, 0);
+    return tokeniter_peek(&parser->iter);
 }
 
 // Consumes a token and moves on to the next token
-inline Token* parser_chomp(Parser* parser) {
-    Token* tok = parser_peek_token(parser);
-    parser->curr_tok += 1;
-    return tok;
+inline TokenIndex parser_chomp(Parser* parser) {
+    parser_fill(parser, 0);
+    return tokeniter_next(&parser->iter);
 }
 
 // Consumes a token and moves on to the next, if the current token matches the expected token.
-inline Token* chomp_if(Parser* parser, TokenKind tokenkind) {
-    if(parser->curr_tok->kind == tokenkind)
+inline TokenIndex chomp_if(Parser* parser, TokenKind tokenkind) {
+    if(parser_peek_kind(parser) == tokenkind)
         return parser_chomp(parser);
 
-    return null;
+    return TOKEN_NONE;
 }
 
 inline void parser_put_back(Parser* parser) {
-    parser->curr_tok -= 1;
+    tokeniter_put_back(&parser->iter);
 }
 
-inline Token* expect_token(Parser* parser, TokenKind tokenkind) {
-    if(parser->curr_tok->kind == tokenkind)
+inline TokenIndex expect_token(Parser* parser, TokenKind tokenkind) {
+    if(parser_peek_kind(parser) == tokenkind)
         return parser_chomp(parser);
         
-    panic(ErrorUnexpectedToken, "Expected `%s`; got `%s`", 
+    parser_error(parser, ErrorUnexpectedToken, "Expected `%s`; got `%s`", 
                                         token_to_buff(tokenkind)->data,
-                                        token_to_buff(parser->curr_tok->kind)->data);
+                                        token_to_buff(parser_peek_kind(parser))->data);
     abort();
 }
 
-AstNode* ast_create_node(AstNodeKind kind) {
-    AstNode* node = cast(AstNode*)calloc(1, sizeof(AstNode));
+// Allocate a zeroed `T` from the Parser's Arena
+#define ast_new(T)  cast(T*)ast_alloc(parser, sizeof(T))
+
+static void* ast_alloc(Parser* parser, UInt64 size) {
+    void* out = arena_alloc(parser->arena, size, sizeof(UInt64));
+    memset(out, 0, size);
+    return out;
+}
+
+static AstNodeExpression* ast_new_expr(Parser* parser, AstNode* node) {
+    node->data.expr = ast_new(AstNodeExpression);
+    return node->data.expr;
+}
+
+static AstNodeStatement* ast_new_stmt(Parser* parser, AstNode* node) {
+    node->data.stmt = ast_new(AstNodeStatement);
+    return node->data.stmt;
+}
+
+// Every node of a given kind keeps its payload in the same member of `node->data`, so the payload is allocated along
+// with the node (right behind it in the Arena)
+AstNode* ast_create_node(Parser* parser, AstNodeKind kind, TokenIndex main_token) {
+    AstNode* node = ast_new(AstNode);
     node->kind = kind;
+    node->main_token = main_token;
+    parser->num_nodes++;
+    switch(kind) {
+        case AstNodeKindIdentifier:
+            node->data.identifier = ast_new(AstNodeIdentifier);
+            break;
+        case AstNodeKindBlock:
+            ast_new_stmt(parser, node)->block_stmt = ast_new(AstNodeBlock);
+            break;
+        case AstNodeKindFuncPrototype:
+            ast_new_stmt(parser, node)->func_proto_decl = ast_new(AstNodeFuncPrototype);
+            break;
+        case AstNodeKindFuncDef:
+            node->data.decl = ast_new(AstNodeDecl);
+            node->data.decl->func_decl = ast_new(AstNodeFuncDecl);
+            break;
+        case AstNodeKindEnumDecl:
+            node->data.type_decl = ast_new(AstNodeTypeDecl);
+            node->data.type_decl->enum_decl = ast_new(AstNodeTypeEnumDecl);
+            break;
+        case AstNodeKindUnionDecl:
+        case AstNodeKindTypeDecl:
+            node->data.type_decl = ast_new(AstNodeTypeDecl);
+            break;
+        case AstNodeKindVarDecl:
+            ast_new_stmt(parser, node)->var_decl = ast_new(AstNodeVarDecl);
+            break;
+        case AstNodeKindFuncCallExpr:
+            ast_new_expr(parser, node)->func_call_expr = ast_new(AstNodeFuncCallExpr);
+            break;
+        case AstNodeKindIfExpr:
+            ast_new_expr(parser, node)->if_expr = ast_new(AstNodeIfExpr);
+            break;
+        case AstNodeKindLoopWhileExpr:
+            ast_new_expr(parser, node)->loop_expr = ast_new(AstNodeLoopExpr);
+            node->data.expr->loop_expr->loop_while_expr = ast_new(AstNodeLoopWhileExpr);
+            break;
+        case AstNodeKindLoopCExpr:
+            ast_new_expr(parser, node)->loop_expr = ast_new(AstNodeLoopExpr);
+            node->data.expr->loop_expr->loop_c_expr = ast_new(AstNodeLoopCExpr);
+            break;
+        case AstNodeKindLoopInExpr:
+            ast_new_expr(parser, node)->loop_expr = ast_new(AstNodeLoopExpr);
+            node->data.expr->loop_expr->loop_in_expr = ast_new(AstNodeLoopInExpr);
+            break;
+        case AstNodeKindMatchExpr:
+            ast_new_expr(parser, node)->match_expr = ast_new(AstNodeMatchExpr);
+            break;
+        case AstNodeKindCatchExpr:
+            ast_new_expr(parser, node)->catch_expr = ast_new(AstNodeCatchExpr);
+            break;
+        case AstNodeKindBinaryOpExpr:
+            ast_new_expr(parser, node)->binary_op_expr = ast_new(AstNodeBinaryOpExpr);
+            break;
+        case AstNodeKindPrefixOpExpr:
+            node->data.prefix_op_expr = ast_new(AstNodePrefixOpExpr);
+            break;
+        case AstNodeKindFieldAccessExpr:
+            node->data.field_access_expr = ast_new(AstNodeFieldAccessExpr);
+            break;
+        case AstNodeKindInitExpr:
+            ast_new_expr(parser, node)->init_expr = ast_new(AstNodeInitExpr);
+            break;
+        case AstNodeKindSliceExpr:
+            ast_new_expr(parser, node)->slice_expr = ast_new(AstNodeSliceExpr);
+            break;
+        case AstNodeKindArrayAccessExpr:
+            node->data.array_access_expr = ast_new(AstNodeArrayAccessExpr);
+            break;
+        case AstNodeKindArrayType:
+            node->data.array_type = ast_new(AstNodeArrayType);
+            break;
+        case AstNodeKindInferredArrayType:
+            node->data.inferred_array_type = ast_new(AstNodeInferredArrayType);
+            break;
+        case AstNodeKindBreak:
+        case AstNodeKindContinue:
+            ast_new_stmt(parser, node)->branch_stmt = ast_new(AstNodeBranchStatement);
+            break;
+        case AstNodeKindParamDecl:
+            node->data.param_decl = ast_new(AstNodeParamDecl);
+            break;
+        case AstNodeKindDefer:
+            ast_new_stmt(parser, node)->defer_stmt = ast_new(AstNodeDeferStatement);
+            break;
+        case AstNodeKindReturn:
+            ast_new_stmt(parser, node)->return_stmt = ast_new(AstNodeReturnStatement);
+            break;
+        case AstNodeKindMatchBranch:
+            ast_new_expr(parser, node)->match_branch_expr = ast_new(AstNodeMatchBranchExpr);
+            break;
+        case AstNodeKindMatchRange:
+            ast_new_expr(parser, node)->match_range_expr = ast_new(AstNodeMatchRangeExpr);
+            break;
+        default:
+            // Literals (and `unreachable`) have no payload: their value is the source text of their token
+            break;
+    }
     return node;
 }
 
-AstNode* ast_clone_node(AstNode* node) {
+AstNode* ast_clone_node(Parser* parser, AstNode* node) {
     if(!node)
         panic(ErrorUnexpectedNull, "Trying to clone a null AstNode?");
-    AstNode* new = ast_create_node(node->kind);
+    AstNode* new = ast_create_node(parser, node->kind, node->main_token);
     // TODO(jasmcaus): Add more struct members
     return new;
 }
@@ -88,11 +276,6 @@ AstNode* ast_clone_node(AstNode* node) {
 
     Related source code: https://github.com/ziglang/zig/blob/master/src/stage1/parser.cpp
 */
-typedef enum BinaryOpChain {
-    BinaryOpChainOnce,
-    BinaryOpChainInfinity
-} BinaryOpChain;
-
 static AstNode* ast_parse_func_call_args(Parser* parser);
 static AstNode* ast_parse_suffix_op(Parser* parser);
 static AstNode* ast_parse_prefix_op_expr(Parser* parser,
@@ -100,42 +283,22 @@ static AstNode* ast_parse_prefix_op_expr(Parser* parser,
                                          AstNode* (*child_parser)(Parser*));
 static AstNode* ast_parse_prefix_type_op(Parser* parser);
 static AstNode* ast_parse_prefix_op(Parser* parser);
-static AstNode* ast_parse_multiplication_op(Parser* parser);
-static AstNode* ast_parse_addition_op(Parser* parser);
-static AstNode* ast_parse_bitshift_op(Parser* parser);
-static AstNode* ast_parse_bitwise_op(Parser* parser);
-static AstNode* ast_parse_comparison_op(Parser* parser);
-static AstNode* ast_parse_assignment_op(Parser* parser);
-static AstNode* ast_parse_op(Parser* parser);
 static AstNode* ast_parse_match_item(Parser* parser);
 static AstNode* ast_parse_match_case_kwd(Parser* parser);
 static AstNode* ast_parse_match_branch(Parser* parser);
-static Token* ast_parse_block_label(Parser* parser);
-static Token* ast_parse_break_label(Parser* parser);
+static Buff* ast_parse_block_label(Parser* parser);
+static Buff* ast_parse_break_label(Parser* parser);
 static AstNode* ast_parse_match_expr(Parser* parser);
 static AstNode* ast_parse_primary_type_expr(Parser* parser);
 static AstNode* ast_parse_suffix_expr(Parser* parser);
 static AstNode* ast_parse_type_expr(Parser* parser);
 static AstNode* ast_parse_init_list(Parser* parser);
 static AstNode* ast_parse_if_expr(Parser* parser);
-static AstNode* ast_parse_boolean_and_op(Parser* parser);
-static AstNode* ast_parse_boolean_or_op(Parser* parser);
 static AstNode* ast_parse_primary_expr(Parser* parser);
 static AstNode* ast_parse_prefix_expr(Parser* parser);
-static AstNode* ast_parse_multiplication_expr(Parser* parser);
-static AstNode* ast_parse_addition_expr(Parser* parser);
-static AstNode* ast_parse_bitshift_expr(Parser* parser);
-static AstNode* ast_parse_bitwise_expr(Parser* parser);
-static AstNode* ast_parse_comparison_expr(Parser* parser);
-static AstNode* ast_parse_boolean_or_expr(Parser* parser);
-static AstNode* ast_parse_boolean_and_expr(Parser* parser);
 static AstNode* ast_parse_expr(Parser* parser);
 static AstNode* ast_parse_try_expr(Parser* parser);
-static AstNode* ast_parse_binary_op_expr(Parser* parser, BinaryOpChain chain,
-                                         AstNode* (*op_parser)(Parser*),
-                                         AstNode* (*child_parser)(Parser*)
-);
-static BinaryOpKind tokenkind_to_binaryopkind(TokenKind kind);
+static AstNode* ast_parse_binary_expr(Parser* parser, UInt8 min_prec);
 static AstNode* ast_parse_block(Parser* parser);
 static AstNode* ast_parse_assignment_expr(Parser* parser);
 static AstNode* ast_parse_block_expr(Parser* parser);
@@ -148,46 +311,68 @@ static AstNode* ast_parse_var_decl(Parser* parser);
 static AstNode* ast_parse_func_prototype(Parser* parser);
 
 static Vec* ast_parse_param_list(Parser* parser, AstNode* (*param_parser)(Parser* parser)) {
-    Vec* out = vec_new(AstNode, 1);
+    Vec* out = vec_new_in(parser->arena, AstNode, 1);
     while(true) {
         AstNode* curr = param_parser(parser);
         if(curr == null)
             break;
         vec_push(out, curr);
 
-        Token* sep = parser_chomp_if(COMMA);
-        if(sep == null)
+        TokenIndex sep = parser_chomp_if(COMMA);
+        if(sep == TOKEN_NONE)
             break;
-        free(sep);
     }
     return out;
 }
 
+// Function bodies can only be skipped if the whole token list is at hand (a streaming Lexer only keeps a window of
+// it) and the Lexer found every `{` to be closed (`nest_level` is the balance of the braces of the whole file).
+// Otherwise bodies are parsed as they come, which reports a missing `}` where it is.
+static inline bool parser_can_skip_bodies(Parser* parser) {
+    return parser->lazy_bodies && pt->mask == TOKENLIST_NO_MASK && parser->lexer->nest_level == 0;
+}
+
+// Returns the RBRACE matching the LBRACE at `lbrace`, or TOKEN_NONE if it isn't closed.
+// Only the (dense) array of kinds is walked - none of the tokens in between are parsed.
+static TokenIndex parser_matching_brace(Parser* parser, TokenIndex lbrace) {
+    const UInt8* kinds = pt->kinds;
+    int nesting = 0;
+    for(TokenIndex i = lbrace; i < pt->size; i++) {
+        if(kinds[i] == LBRACE)
+            nesting++;
+        else if(kinds[i] == RBRACE && --nesting == 0)
+            return i;
+    }
+    return TOKEN_NONE;
+}
+
 // General format:
-//      KEYWORD(func) IDENT LPAREN ParamDeclList RPAREN LARROW RETURNTYPE
+//      KEYWORD(func) IDENT LPAREN ParamDeclList RPAREN LARROW RETURNTYPE Block?
+// With `parser->lazy_bodies`, the Block is only recorded as a token range (see `parser_parse_body()`)
 static AstNode* ast_parse_func_prototype(Parser* parser) {
-    Token* func = parser_chomp_if(FUNC);
-    if(func == null)
+    TokenIndex func = parser_chomp_if(FUNC);
+    if(func == TOKEN_NONE)
         return null;
     
-    Token* identifier = parser_chomp_if(IDENTIFIER);
-    Token* lparen = parser_expect_token(LPAREN);
+    // Names are read as soon as they're chomped: with a streaming Lexer, the token may have left the window by the time
+    // the node is built
+    TokenIndex identifier = parser_chomp_if(IDENTIFIER);
+    Buff* name = identifier != TOKEN_NONE ? parser_token_value(parser, identifier) : null;
+    TokenIndex lparen = parser_expect_token(LPAREN);
     Vec* params = ast_parse_param_list(parser, ast_parse_match_branch);
-    Token* rparen = parser_expect_token(RPAREN);
-    free(lparen);
-    free(rparen);
+    TokenIndex rparen = parser_expect_token(RPAREN);
 
     AstNode* return_type = ast_parse_type_expr(parser);
     if(return_type == null) {
-        Token* next = parser_peek_token(parser);
+        TokenIndex next = parser_peek_token(parser);
         ast_error(
             "expected return type; found`%s`",
-            token_to_buff(next->kind)->data
+            token_to_buff(parser_token_kind(parser, next))->data
         );
     }
 
-    AstNode* out = ast_create_node(AstNodeKindFuncPrototype);
-    out->data.stmt->func_proto_decl->name = identifier->value;
+    AstNode* out = ast_create_node(parser, AstNodeKindFuncPrototype, identifier != TOKEN_NONE ? identifier : func);
+    out->data.stmt->func_proto_decl->name = name;
     out->data.stmt->func_proto_decl->params = params;
     out->data.stmt->func_proto_decl->return_type = return_type;
 
@@ -204,33 +389,72 @@ static AstNode* ast_parse_func_prototype(Parser* parser) {
                 "Cannot have multiple variadic arguments in function prototype"
             );
     }
+
+    out->data.stmt->func_proto_decl->body_begin = TOKEN_NONE;
+    out->data.stmt->func_proto_decl->body_end = TOKEN_NONE;
+    if(parser_peek_kind(parser) == LBRACE) {
+        TokenIndex lbrace = parser_peek_token(parser);
+        TokenIndex rbrace = parser_can_skip_bodies(parser) ? parser_matching_brace(parser, lbrace) : TOKEN_NONE;
+        if(rbrace != TOKEN_NONE) {
+            // Skip the body: `parser_parse_body()` comes back for it
+            out->data.stmt->func_proto_decl->body_begin = lbrace;
+            out->data.stmt->func_proto_decl->body_end = rbrace;
+            parser->iter.index = rbrace + 1;
+        } else {
+            out->data.stmt->func_proto_decl->func_def = ast_parse_block(parser);
+        }
+    }
     return out;
 }
 
+AstNode* parser_parse_body(Parser* parser, AstNode* func) {
+    CORETEN_ENFORCE(func->kind == AstNodeKindFuncPrototype);
+    AstNodeFuncPrototype* proto = func->data.stmt->func_proto_decl;
+    if(proto->body_begin == TOKEN_NONE)
+        return proto->func_def;
+
+    // Parse the body where it stands in the token list, then pick up where the Parser was
+    TokenIndex resume = parser->iter.index;
+    parser->iter.index = proto->body_begin;
+    proto->func_def = ast_parse_block(parser);
+    CORETEN_ENFORCE(parser->iter.index == proto->body_end + 1);
+    parser->iter.index = resume;
+
+    proto->body_begin = TOKEN_NONE;
+    proto->body_end = TOKEN_NONE;
+    return proto->func_def;
+}
+
 // General format:
 // `?` represents optional
 //      KEYWORD(export)? KEYWORD(mutable/const)? TypeExpr? IDENTIFIER EQUAL? Expr?
 static AstNode* ast_parse_var_decl(Parser* parser) {
-    Token* export_kwd = parser_chomp_if(EXPORT);
-    Token* mutable_kwd = parser_chomp_if(MUTABLE);
-    Token* const_kwd = parser_chomp_if(CONST);
-    if(mutable_kwd && const_kwd)
+    TokenIndex export_kwd = parser_chomp_if(EXPORT);
+    TokenIndex mutable_kwd = parser_chomp_if(MUTABLE);
+    TokenIndex const_kwd = parser_chomp_if(CONST);
+    if(mutable_kwd != TOKEN_NONE && const_kwd != TOKEN_NONE)
         ast_error("Cannot decorate a variable as both `mutable` and `const`");
 
     AstNode* type_expr = ast_parse_type_expr(parser);
-    Token* identifier = parser_expect_token(IDENTIFIER);
-    Token* equals = parser_chomp_if(EQUALS);
-    AstNode* expr;
-    if(equals != null)
+    // Not a declaration (e.g. the `}` that ends a block)
+    if(type_expr == null && export_kwd == TOKEN_NONE && mutable_kwd == TOKEN_NONE && const_kwd == TOKEN_NONE)
+        return null;
+
+    TokenIndex identifier = parser_expect_token(IDENTIFIER);
+    Buff* name = parser_token_value(parser, identifier);
+    TokenIndex equals = parser_chomp_if(EQUALS);
+    AstNode* expr = null;
+    if(equals != TOKEN_NONE)
         expr = ast_parse_expr(parser);
     
     parser_expect_token(SEMICOLON); // TODO: Remove this need
 
-    AstNode* out = ast_create_node(AstNodeKindVarDecl);
-    out->data.stmt->var_decl->name = identifier->value;
-    out->data.stmt->var_decl->is_export = export_kwd != null;
-    out->data.stmt->var_decl->is_mutable = mutable_kwd != null;
-    out->data.stmt->var_decl->is_const = const_kwd != null;
+    AstNode* out = ast_create_node(parser, AstNodeKindVarDecl, identifier);
+    out->data.stmt->var_decl->name = name;
+    out->data.stmt->var_decl->type = type_expr;
+    out->data.stmt->var_decl->is_export = export_kwd != TOKEN_NONE;
+    out->data.stmt->var_decl->is_mutable = mutable_kwd != TOKEN_NONE;
+    out->data.stmt->var_decl->is_const = const_kwd != TOKEN_NONE;
     out->data.stmt->var_decl->expr = expr;
     return out;
 }
@@ -242,59 +466,50 @@ static AstNode* ast_parse_statement(Parser* parser) {
         CORETEN_ENFORCE(var_decl->kind == AstNodeKindVarDecl);
         return var_decl;
     }
-    free(var_decl);
 
     // Defer
-    Token* defer_stmt = parser_chomp_if(DEFER);
-    if(defer_stmt != null) {
+    TokenIndex defer_stmt = parser_chomp_if(DEFER);
+    if(defer_stmt != TOKEN_NONE) {
         AstNode* statement = ast_parse_block_expr_statement(parser);
-        AstNode* out = ast_create_node(AstNodeKindDefer);
+        AstNode* out = ast_create_node(parser, AstNodeKindDefer, defer_stmt);
         
         out->data.stmt->defer_stmt->expr = statement;
         return out;
     }
-    free(defer_stmt);
 
     // If statement
     AstNode* if_statement = ast_parse_if_expr(parser);
     if(if_statement != null)
         return if_statement;
-    free(if_statement);
     
     // Labeled Statements
     AstNode* labeled_statement = ast_parse_labeled_statements(parser);
     if(labeled_statement != null)
         return labeled_statement;
-    free(labeled_statement);
 
     // Match statements
     AstNode* match_expr = ast_parse_match_expr(parser);
     if(match_expr != null)
         return match_expr;
-    free(match_expr);
 
     // Assignment statements
     AstNode* assignment_expr = ast_parse_assignment_expr(parser);
     if(assignment_expr != null)
         return assignment_expr;
-    free(assignment_expr);
 
     return null;
 }
 
 static AstNode* ast_parse_if_prefix(Parser* parser) {
-    Token* if_kwd = parser_chomp_if(IF);
-    if(if_kwd == null) {
-        free(if_kwd);
+    TokenIndex if_kwd = parser_chomp_if(IF);
+    if(if_kwd == TOKEN_NONE) {
         return null;
     }
-    Token* lparen = parser_expect_token(LPAREN);
+    TokenIndex lparen = parser_expect_token(LPAREN);
     AstNode* condition = ast_parse_expr(parser);
-    Token* rparen = parser_expect_token(RPAREN);
-    free(lparen);
-    free(rparen);
+    TokenIndex rparen = parser_expect_token(RPAREN);
 
-    AstNode* out = ast_create_node(AstNodeKindIfExpr);
+    AstNode* out = ast_create_node(parser, AstNodeKindIfExpr, if_kwd);
     out->data.expr->if_expr->condition = condition;
 
     return out;
@@ -302,28 +517,25 @@ static AstNode* ast_parse_if_prefix(Parser* parser) {
 
 static AstNode* ast_parse_if_expr(Parser* parser) {
     AstNode* out = ast_parse_if_prefix(parser);
-    if(out == null) {
-        free(out);
+    if(out == null)
         return null;
-    }
     
     AstNode* body = ast_parse_block_expr(parser);
     if(body == null)
         body = ast_parse_assignment_expr(parser);
     
     if(body == null) {
-        Token* token = parser_chomp(parser);
+        TokenIndex token = parser_chomp(parser);
         ast_error(
             "expected `if` body; found `%s`",
-            token_to_buff(token->kind)->data
+            token_to_buff(parser_token_kind(parser, token))->data
         );
     }
 
     AstNode* else_body = null;
-    Token* else_kwd = parser_chomp_if(ELSE);
-    if(else_kwd != null)
+    TokenIndex else_kwd = parser_chomp_if(ELSE);
+    if(else_kwd != TOKEN_NONE)
         else_body = ast_parse_statement(parser);
-    free(else_kwd);
 
     out->data.expr->if_expr->then_block = body;
     out->data.expr->if_expr->has_else = else_body != null;
@@ -333,26 +545,26 @@ static AstNode* ast_parse_if_expr(Parser* parser) {
 
 // Labeled Statements
 static AstNode* ast_parse_labeled_statements(Parser* parser) {
-    Token* label = ast_parse_block_label(parser);
+    Buff* label = ast_parse_block_label(parser);
     AstNode* block = ast_parse_block(parser);
     if(block != null) {
         CORETEN_ENFORCE(block->kind == AstNodeKindBlock);
-        block->data.stmt->block_stmt->name = label->value;
+        block->data.stmt->block_stmt->name = label;
         return block;
     }
-    free(block);
 
     AstNode* loop = ast_parse_loop_statement(parser);
     if(loop != null) {
-        loop->data.expr->loop_expr->label = label->value;
+        loop->data.expr->loop_expr->label = label;
         return loop;
     }
 
     if(label != null)
-        panic(
+        parser_error(
+            parser,
             ErrorUnexpectedToken,
             "invalid token: `%s`",
-            parser_peek_token(parser)->value->data
+            parser_token_value(parser, parser_peek_token(parser))->data
         );
         
     return null;
@@ -361,15 +573,17 @@ static AstNode* ast_parse_labeled_statements(Parser* parser) {
 // Loops
 //      (KEYWORD(inline))? loop ... {  }
 static AstNode* ast_parse_loop_statement(Parser* parser) {
-    Token* inline_token = parser_chomp_if(INLINE);
+    TokenIndex inline_token = parser_chomp_if(INLINE);
 
-    CORETEN_ENFORCE(false);
-    // TODO
+    // Loops aren't parsed yet: refuse them rather than misparse the statements around them
+    TokenKind kind = parser_peek_kind(parser);
+    if(kind == FOR || kind == WHILE)
+        parser_error(parser, ErrorParseError, "`%s` loops are not supported yet", token_to_buff(kind)->data);
 
     // AstNode* loop_c_statement = ast_parse_loop_c_statement(parser);
     // if(loop_c_statement != null) {
     //     CORETEN_ENFORCE(loop_c_statement->kind == AstNodeKindLoopCExpr);
-    //     loop_c_statement->data.expr->loop_expr->loop_c_expr->is_inline = inline_token != null;
+    //     loop_c_statement->data.expr->loop_expr->loop_c_expr->is_inline = inline_token != TOKEN_NONE;
     //     free(inline_token);
     //     return loop_c_statement;
     // }
@@ -377,7 +591,7 @@ static AstNode* ast_parse_loop_statement(Parser* parser) {
     // AstNode* loop_while_statement = ast_parse_loop_while_statement(parser);
     // if(loop_while_statement != null) {
     //     CORETEN_ENFORCE(loop_while_statement->kind == AstNodeKindLoopWhileExpr);
-    //     loop_while_statement->data.expr->loop_expr->loop_while_expr->is_inline = inline_token != null;
+    //     loop_while_statement->data.expr->loop_expr->loop_while_expr->is_inline = inline_token != TOKEN_NONE;
     //     free(inline_token);
     //     return loop_while_statement;
     // }
@@ -385,16 +599,17 @@ static AstNode* ast_parse_loop_statement(Parser* parser) {
     // AstNode* loop_in_statement = ast_parse_loop_in_statement(parser);
     // if(loop_in_statement != null) {
     //     CORETEN_ENFORCE(loop_in_statement->kind == AstNodeKindLoopWhileExpr);
-    //     loop_in_statement->data.expr->loop_expr->loop_in_expr->is_inline = inline_token != null;
+    //     loop_in_statement->data.expr->loop_expr->loop_in_expr->is_inline = inline_token != TOKEN_NONE;
     //     free(inline_token);
     //     return loop_in_statement;
     // }
 
-    if(inline_token != null)
-        panic(
+    if(inline_token != TOKEN_NONE)
+        parser_error(
+            parser,
             ErrorUnexpectedToken,
             "invalid token: `%s`",
-            parser_peek_token(parser)->value->data
+            parser_token_value(parser, parser_peek_token(parser))->data
         );
     
     return null;
@@ -410,8 +625,7 @@ static AstNode* ast_parse_block_expr_statement(Parser* parser) {
     
     AstNode* assignment_expr = ast_parse_assignment_expr(parser);
     if(assignment_expr != null) {
-        Token* semi = parser_expect_token(SEMICOLON);
-        free(semi);
+        TokenIndex semi = parser_expect_token(SEMICOLON);
         return assignment_expr;
     }
     
@@ -421,178 +635,84 @@ static AstNode* ast_parse_block_expr_statement(Parser* parser) {
 // Block Expression
 //      (BlockLabel)? block
 static AstNode* ast_parse_block_expr(Parser* parser) {
-    Token* block_label = ast_parse_block_label(parser);
+    Buff* block_label = ast_parse_block_label(parser);
     if(block_label != null) {
         AstNode* out = ast_parse_block(parser);
         CORETEN_ENFORCE(out->kind == AstNodeKindBlock);
-        out->data.stmt->block_stmt->name = block_label->value;
+        out->data.stmt->block_stmt->name = block_label;
         return out;
     }
 
     return ast_parse_block(parser);
 }
 
-// AssignmentExpr
-//      Expr (AssignmentOp Expr)?
-// AssignmentOp can be one of:
-//      | MULT_EQUALS       (*=)
-//      | SLASH_EQUALS      (/=)
-//      | MOD_EQUALS        (%=)
-//      | PLUS_EQUALS       (+=)
-//      | MINUS_EQUALS      (-=)
-//      | LBITSHIFT_EQUALS  (<<=)
-//      | RBITSHIFT_EQUALS  (>>=)
-//      | AND_EQUALS        (&=)
-//      | XOR_EQUALS        (^=)
-//      | OR_EQUALS         (|=)
-//      | TILDA             (~)
-//      | TILDA_EQUALS      (~=)
-//      | EQUALS            (=)
-static AstNode* ast_parse_assignment_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainOnce,
-        ast_parse_assignment_op,
-        ast_parse_expr
-    );
-}
-
 static AstNode* ast_parse_block(Parser* parser) {
-    Token* lbrace = parser_chomp_if(LBRACE);
-    if(lbrace == null)
+    TokenIndex lbrace = parser_chomp_if(LBRACE);
+    if(lbrace == TOKEN_NONE)
         return null;
 
-    Vec* statements = vec_new(AstNode, 1);
+    Vec* statements = vec_new_in(parser->arena, AstNode, 1);
     AstNode* statement = null;
     while((statement = ast_parse_statement(parser)) != null)
         vec_push(statements, statement);
 
-    Token* rbrace = parser_expect_token(RBRACE);
-    free(lbrace);
-    free(rbrace);
+    TokenIndex rbrace = parser_expect_token(RBRACE);
 
-    AstNode* out = ast_create_node(AstNodeKindBlock);
+    AstNode* out = ast_create_node(parser, AstNodeKindBlock, lbrace);
     out->data.stmt->block_stmt->statements = statements;
     return out;
 }
 
-typedef struct ast_prec_table {
-    TokenKind tok_kind;
-    UInt8 prec_value;
-    BinaryOpKind bin_kind;
-} ast_prec_table;
-
-// A table of binary operator precedence. Higher precedence numbers are stickier.
-static const ast_prec_table precedence_table[] = {
-    // { MULT_MULT, 60, BinaryOpKindMultMult  },
-    { MULT, 60, BinaryOpKindMult  },
-    { MOD, 60, BinaryOpKindMod  },
-    { SLASH, 60, BinaryOpKindDiv  },
-
-    { PLUS, 50, BinaryOpKindAdd  },
-    { MINUS, 50, BinaryOpKindSubtract  },
-    { PLUS_EQUALS, 50, BinaryOpKindAssignmentPlus  },
-    { MINUS_EQUALS, 50, BinaryOpKindAssignmentMinus  },
-
-    { LBITSHIFT, 40, BinaryOpKindBitshitLeft  },
-    { RBITSHIFT, 40, BinaryOpKindBitshitRight  },
-    
-    { EQUALS_EQUALS, 30, BinaryOpKindCmpEqual  },
-    { EXCLAMATION_EQUALS, 30, BinaryOpKindCmpNotEqual  },
-    { GREATER_THAN, 30, BinaryOpKindCmpGreaterThan  },
-    { LESS_THAN, 30, BinaryOpKindCmpLessThan  },
-    { GREATER_THAN_OR_EQUAL_TO, 30, BinaryOpKindCmpGreaterThanorEqualTo  },
-    { LESS_THAN_OR_EQUAL_TO, 30, BinaryOpKindCmpLessThanorEqualTo  },
-
-    { AND, 20, BinaryOpKindBoolAnd  },
-
-    { OR, 10, BinaryOpKindBoolOr  },
-};
-
-// Returns the `BinaryOpKind` representation of a `TokenKind`
-static BinaryOpKind tokenkind_to_binaryopkind(TokenKind kind) {
-    BinaryOpKind value;
-    switch(kind) {
-        // AdditionOp
-        case PLUS: value = BinaryOpKindAdd; break;
-        case MINUS: value = BinaryOpKindSubtract; break;
-        case MULT: value = BinaryOpKindMult; break;
-        case SLASH: value = BinaryOpKindDiv; break;
-        case MOD: value = BinaryOpKindMod; break;
-
-        // ComparisonOp
-        case GREATER_THAN: value = BinaryOpKindCmpGreaterThan; break;
-        case LESS_THAN: value = BinaryOpKindCmpLessThan; break;
-        case GREATER_THAN_OR_EQUAL_TO: value = BinaryOpKindCmpGreaterThanorEqualTo; break;
-        case LESS_THAN_OR_EQUAL_TO: value = BinaryOpKindCmpLessThanorEqualTo; break;
-        case EQUALS_EQUALS: value = BinaryOpKindCmpEqual; break;
-        case EXCLAMATION_EQUALS: value = BinaryOpKindCmpNotEqual; break;
-
-        // AssignmentOp
-        case PLUS_EQUALS: value = BinaryOpKindAssignmentPlus; break;
-        case MINUS_EQUALS: value = BinaryOpKindAssignmentMinus; break;
-        case MULT_EQUALS: value = BinaryOpKindAssignmentMult; break;
-        case SLASH_EQUALS: value = BinaryOpKindAssignmentDiv; break;
-        case MOD_EQUALS: value = BinaryOpKindAssignmentMod; break;
-        case AND_EQUALS: value = BinaryOpKindAssignmentBitAnd; break;
-        case OR_EQUALS : value = BinaryOpKindAssignmentBitOr; break;
-        case XOR_EQUALS: value = BinaryOpKindAssignmentBitXor; break;
-        case LBITSHIFT_EQUALS : value = BinaryOpKindAssignmentBitshiftLeft; break;
-        case RBITSHIFT_EQUALS : value = BinaryOpKindAssignmentBitshiftRight; break;
-
-        // BitshiftOp
-        case LBITSHIFT: value = BinaryOpKindBitshitLeft; break;
-        case RBITSHIFT: value = BinaryOpKindBitshitRight; break;
-
-        // BitwiseOp
-        case AND: value = BinaryOpKindBitAnd; break;
-        case OR: value = BinaryOpKindBitOr; break;
-        case XOR: value = BinaryOpKindBitXor; break;
-
-        // We should _never_ reach here
-        default: value = BinaryOpKindInvalid; break;
-    }
-
-    return value;
-}
-
-// A `generic`-like function that parses binary expressions.
-// These (expressions) utilize similar functionality, so this function is here to avoid code duplication.
-// Here, `op_parser` parses the operand (e.g. `+=`, `or`...)
-static AstNode* ast_parse_binary_op_expr(
-    Parser* parser,
-    BinaryOpChain chain,
-    AstNode* (*op_parser)(Parser*),
-    AstNode* (*child_parser)(Parser*)
-) {
-    AstNode* out = child_parser(parser);
+// How a binary operator groups with the operators of the same precedence
+typedef enum AstAssoc {
+    AstAssocLeft,   // `a - b - c` is `(a - b) - c`
+    AstAssocRight,  // `a = b = c` is `a = (b = c)`
+    AstAssocNone    // `a < b < c` is an error
+} AstAssoc;
+
+// Operator tables indexed by TokenKind (generated from `ALLTOKENS` by `tools/scripts/generate_tokens.py`)
+#include <adorad/compiler/parser_tables.h>
+
+// Parses a chain of binary operators (binding at least as tight as `min_prec`) and their operands by precedence
+// climbing: a single loop over `parserPrecedence`, which only recurses to parse an operand that binds tighter than
+// the operator to its left. Operands are PrefixExprs.
+static AstNode* ast_parse_binary_expr(Parser* parser, UInt8 min_prec) {
+    AstNode* out = ast_parse_prefix_expr(parser);
     if(out == null)
         return null;
 
-    do {
-        AstNode* op = op_parser(parser);
-        if(op == null)
+    UInt8 last_prec = 0;
+    while(true) {
+        TokenKind kind = parser_peek_kind(parser);
+        UInt8 prec = parserPrecedence[kind];
+        if(prec == 0 || prec < min_prec)
             break;
-
-        AstNode* left = out;
-        AstNode* right = child_parser(parser);
-        out = op;
-
-        if(op->kind == AstNodeKindBinaryOpExpr) {
-            op->data.expr->binary_op_expr->lhs = left;
-            op->data.expr->binary_op_expr->rhs = right;
-        } else {
-            unreachable();
-        }
-    } while(chain == BinaryOpChainInfinity);
+        if(parserAssoc[kind] == AstAssocNone && prec == last_prec)
+            ast_error("Comparison operators cannot be chained; found `%s`", token_to_buff(kind)->data);
+
+        TokenIndex op_token = parser_chomp(parser);
+        // The right operand of a left-associative operator stops at the next operator of the same precedence, so
+        // that it groups to the left. A right-associative one takes it along.
+        UInt8 next_prec = parserAssoc[kind] == AstAssocRight ? prec : prec + 1;
+        AstNode* right = ast_parse_binary_expr(parser, next_prec);
+        if(right == null)
+            ast_error("Expected an expression after `%s`", token_to_buff(kind)->data);
+
+        AstNode* binary = ast_create_node(parser, AstNodeKindBinaryOpExpr, op_token);
+        binary->data.expr->binary_op_expr->op = cast(BinaryOpKind)parserBinaryOpKinds[kind];
+        binary->data.expr->binary_op_expr->lhs = out;
+        binary->data.expr->binary_op_expr->rhs = right;
+        out = binary;
+        last_prec = prec;
+    }
 
     return out;
 }
 
 static AstNode* ast_parse_try_expr(Parser* parser) {
-    Token* try_kwd = parser_chomp_if(TRY);
-    if(try_kwd != null) {
-        AstNode* out = ast_create_node(AstNodeKindReturn);
+    TokenIndex try_kwd = parser_chomp_if(TRY);
+    if(try_kwd != TOKEN_NONE) {
+        AstNode* out = ast_create_node(parser, AstNodeKindReturn, try_kwd);
         out->data.stmt->return_stmt->kind = ReturnKindError;
         return out;
     }
@@ -600,88 +720,51 @@ static AstNode* ast_parse_try_expr(Parser* parser) {
 }
 
 // Expr
-//      KEYWORD(try)* BoolAndExpr
+//      KEYWORD(try)* BinaryExpr
+// BinaryExpr is any chain of the binary operators in `parserPrecedence` (but the assignment operators)
+static AstNode* ast_parse_operator_expr(Parser* parser) {
+    return ast_parse_binary_expr(parser, PARSER_PREC_ASSIGNMENT + 1);
+}
+
 static AstNode* ast_parse_expr(Parser* parser) {
     return ast_parse_prefix_op_expr(
         parser,
         ast_parse_try_expr,
-        ast_parse_boolean_and_expr
-    );
-}
-
-// BooleanAndExpr
-static AstNode* ast_parse_boolean_and_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainInfinity,
-        ast_parse_boolean_and_op,
-        ast_parse_boolean_or_expr
+        ast_parse_operator_expr
     );
 }
 
-// BooleanOrExpr
-static AstNode* ast_parse_boolean_or_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainInfinity,
-        ast_parse_boolean_or_op,
-        ast_parse_comparison_expr
-    );
-}
-
-// ComparisonExpr
-//      BitwiseExpr (ComparisonOp BitwiseExpr)*
-static AstNode* ast_parse_comparison_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainOnce,
-        ast_parse_comparison_op,
-        ast_parse_bitwise_expr
-    ); 
-}
-
-// BitwiseExpr
-//      BitShiftExpr (BitwiseOp BitShiftExpr)*
-static AstNode* ast_parse_bitwise_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainInfinity,
-        ast_parse_bitwise_op,
-        ast_parse_bitshift_expr
-    ); 
-}
-
-// BitShiftExpr
-//      AdditionExpr (BitshiftOp AdditionExpr)*
-static AstNode* ast_parse_bitshift_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainInfinity,
-        ast_parse_bitshift_op,
-        ast_parse_addition_expr
-    ); 
-}
-
-// AdditionExpr
-//      MultiplyExpr (AdditionOp MultiplyExpr)*
-static AstNode* ast_parse_addition_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainInfinity,
-        ast_parse_addition_op,
-        ast_parse_multiplication_expr
-    ); 
-}
+// AssignmentExpr
+//      Expr (AssignmentOp AssignmentExpr)?
+// AssignmentOp can be one of:
+//      | MULT_EQUALS       (*=)
+//      | SLASH_EQUALS      (/=)
+//      | MOD_EQUALS        (%=)
+//      | PLUS_EQUALS       (+=)
+//      | MINUS_EQUALS      (-=)
+//      | LBITSHIFT_EQUALS  (<<=)
+//      | RBITSHIFT_EQUALS  (>>=)
+//      | AND_EQUALS        (&=)
+//      | XOR_EQUALS        (^=)
+//      | OR_EQUALS         (|=)
+//      | EQUALS            (=)
+static AstNode* ast_parse_assignment_expr(Parser* parser) {
+    AstNode* out = ast_parse_expr(parser);
+    TokenKind kind = parser_peek_kind(parser);
+    if(out == null || !parserIsAssignmentOp[kind])
+        return out;
 
-// MultiplyExpr
-//      AdditionExpr (MultiplicationOp AdditionExpr)*
-static AstNode* ast_parse_multiplication_expr(Parser* parser) {
-    return ast_parse_binary_op_expr(
-        parser,
-        BinaryOpChainInfinity,
-        ast_parse_multiplication_op,
-        ast_parse_bitwise_expr
-    ); 
+    TokenIndex op_token = parser_chomp(parser);
+    // Assignments are right-associative
+    AstNode* right = ast_parse_assignment_expr(parser);
+    if(right == null)
+        ast_error("Expected an expression after `%s`", token_to_buff(kind)->data);
+
+    AstNode* assignment = ast_create_node(parser, AstNodeKindBinaryOpExpr, op_token);
+    assignment->data.expr->binary_op_expr->op = cast(BinaryOpKind)parserBinaryOpKinds[kind];
+    assignment->data.expr->binary_op_expr->lhs = out;
+    assignment->data.expr->binary_op_expr->rhs = right;
+    return assignment;
 }
 
 // PrefixExpr
@@ -708,45 +791,45 @@ static AstNode* ast_parse_prefix_expr(Parser* parser) {
 //      | KEYWORD(return) Expr?
 //      | BlockLabel? LoopExpr
 //      | Block
+//      | TypeExpr
 static AstNode* ast_parse_primary_expr(Parser* parser) {
     AstNode* if_expr = ast_parse_if_expr(parser);
     if (if_expr != null)
         return if_expr;
 
-    Token* break_token = parser_chomp_if(BREAK);
-    if(break_token != null) {
-        free(break_token);
-        Token* label = ast_parse_break_label(parser);
+    TokenIndex break_token = parser_chomp_if(BREAK);
+    if(break_token != TOKEN_NONE) {
+        Buff* label = ast_parse_break_label(parser);
         AstNode* expr = ast_parse_expr(parser);
         
-        AstNode* out = ast_create_node(AstNodeKindBreak);
-        out->data.stmt->branch_stmt->name = label->value;
+        AstNode* out = ast_create_node(parser, AstNodeKindBreak, break_token);
+        out->data.stmt->branch_stmt->name = label;
         out->data.stmt->branch_stmt->type = AstNodeBranchStatementBreak;
         out->data.stmt->branch_stmt->expr = expr;
         return out;
     }
     
-    Token* continue_token = parser_chomp_if(CONTINUE);
-    if(continue_token != null) {
-        Token* label = ast_parse_break_label(parser);
-        AstNode* out = ast_create_node(AstNodeKindContinue);
-        out->data.stmt->branch_stmt->name = label == null ? label->value : null;
+    TokenIndex continue_token = parser_chomp_if(CONTINUE);
+    if(continue_token != TOKEN_NONE) {
+        Buff* label = ast_parse_break_label(parser);
+        AstNode* out = ast_create_node(parser, AstNodeKindContinue, continue_token);
+        out->data.stmt->branch_stmt->name = label;
         out->data.stmt->branch_stmt->type = AstNodeBranchStatementContinue;
+        return out;
     }
 
-    // Token* attribute = parser_chomp_if(ATTRIBUTE);
+    // TokenIndex attribute = parser_chomp_if(ATTRIBUTE);
     // if (attribute != 0) {
     //     AstNode* expr = ast_parse_expr();
-    //     AstNode* out = ast_create_node(AstNodeKindAttribute);
+    //     AstNode* out = ast_create_node(parser, AstNodeKindAttribute, attribute);
     //     out->data.attribute_expr.expr = expr;
     //     return out;
     // }
 
-    Token* return_token = parser_chomp_if(RETURN);
-    if(return_token != null) {
-        free(return_token);
+    TokenIndex return_token = parser_chomp_if(RETURN);
+    if(return_token != TOKEN_NONE) {
         AstNode* expr = ast_parse_expr(parser);
-        AstNode* out = ast_create_node(AstNodeKindReturn);
+        AstNode* out = ast_create_node(parser, AstNodeKindReturn, return_token);
         out->data.stmt->return_stmt->expr = expr;
         return out;
     }
@@ -755,27 +838,8 @@ static AstNode* ast_parse_primary_expr(Parser* parser) {
     if(block != null)
         return block;
     
-    return null;
-}
-
-static AstNode* ast_parse_boolean_and_op(Parser* parser) {
-    Token* op_token = parser_chomp_if(AND);
-    if(op_token == null)
-        return null;
-    
-    AstNode* out = ast_create_node(AstNodeKindBinaryOpExpr);
-    out->data.expr->binary_op_expr->op = BinaryOpKindBoolAnd;
-    return out;
-}
-
-static AstNode* ast_parse_boolean_or_op(Parser* parser) {
-    Token* op_token = parser_chomp_if(OR);
-    if(op_token == null)
-        return null;
-    
-    AstNode* out = ast_create_node(AstNodeKindBinaryOpExpr);
-    out->data.expr->binary_op_expr->op = BinaryOpKindBoolOr;
-    return out;
+    // Literals, identifiers, calls...
+    return ast_parse_type_expr(parser);
 }
 
 // TODO
@@ -792,34 +856,30 @@ static AstNode* ast_parse_boolean_or_op(Parser* parser) {
 //      | LBRACE Expr (COMMA Expr)* COMMA? RBRACE
 //      | LBRACE RBRACE
 static AstNode* ast_parse_init_list(Parser* parser) {
-    Token* lbrace = parser_chomp_if(LBRACE);
-    if(lbrace == null)
+    TokenIndex lbrace = parser_chomp_if(LBRACE);
+    if(lbrace == TOKEN_NONE)
         return null;
-    free(lbrace);
 
-    AstNode* out = ast_create_node(AstNodeKindInitExpr);
+    AstNode* out = ast_create_node(parser, AstNodeKindInitExpr, lbrace);
     out->data.expr->init_expr->kind = InitExprKindArray;
-    out->data.expr->init_expr->entries = vec_new(AstNode, 1);
+    out->data.expr->init_expr->entries = vec_new_in(parser->arena, AstNode, 1);
 
     AstNode* first = ast_parse_expr(parser);
     if(first != null) {
         vec_push(out->data.expr->init_expr->entries, first);
 
-        Token* comma;
-        while((comma = parser_chomp_if(COMMA)) != null) {
-            free(comma);
+        TokenIndex comma;
+        while((comma = parser_chomp_if(COMMA)) != TOKEN_NONE) {
             AstNode* expr = ast_parse_expr(parser);
             if(expr == null)
                 break;
             vec_push(out->data.expr->init_expr->entries, expr);
         }
 
-        Token* rbrace = parser_expect_token(RBRACE);
-        free(rbrace);
+        TokenIndex rbrace = parser_expect_token(RBRACE);
         return out;
     }
-    Token* rbrace = parser_expect_token(RBRACE);
-    free(rbrace);
+    TokenIndex rbrace = parser_expect_token(RBRACE);
     return out;
 }
 
@@ -848,9 +908,9 @@ static AstNode* ast_parse_suffix_expr(Parser* parser) {
                 case AstNodeKindSliceExpr:
                     suffix->data.expr->slice_expr->array_ref_expr = out;
                     break;
-                // case AstNodeKindArrayAccessExpr:
-                //     suffix->data.array_access_expr->array_ref_expr = out;
-                //     break;
+                case AstNodeKindArrayAccessExpr:
+                    suffix->data.array_access_expr->array_ref_expr = out;
+                    break;
                 default:
                     unreachable();
             }
@@ -887,66 +947,57 @@ static AstNode* ast_parse_suffix_expr(Parser* parser) {
 //      | STRING (Literal)
 //      | MatchExpr
 static AstNode* ast_parse_primary_type_expr(Parser* parser) {
-    Token* char_lit = parser_chomp_if(CHAR_LIT);
-    if(char_lit != null) {
-        free(char_lit);
-        return ast_create_node(AstNodeKindCharLiteral);
+    TokenIndex char_lit = parser_chomp_if(CHAR_LIT);
+    if(char_lit != TOKEN_NONE) {
+        return ast_create_node(parser, AstNodeKindCharLiteral, char_lit);
     }
 
-    Token* float_lit = parser_chomp_if(FLOAT_LIT);
-    if(float_lit != null) {
-        free(float_lit);
-        return ast_create_node(AstNodeKindFloatLiteral);
+    TokenIndex float_lit = parser_chomp_if(FLOAT_LIT);
+    if(float_lit != TOKEN_NONE) {
+        return ast_create_node(parser, AstNodeKindFloatLiteral, float_lit);
     }
 
     AstNode* func_prototype = ast_parse_func_prototype(parser);
     if(func_prototype != null)
         return func_prototype;
-    free(func_prototype);
 
-    Token* identifier = parser_chomp_if(IDENTIFIER);
-    if(identifier != null) {
-        free(identifier);
-        return ast_create_node(AstNodeKindIdentifier);
+    TokenIndex identifier = parser_chomp_if(IDENTIFIER);
+    if(identifier != TOKEN_NONE) {
+        return ast_create_node(parser, AstNodeKindIdentifier, identifier);
     }
 
-    // Token* if_type_expr = ast_parse_if_type_expr(parser);
-    // if(if_type_expr != null)
+    // TokenIndex if_type_expr = ast_parse_if_type_expr(parser);
+    // if(if_type_expr != TOKEN_NONE)
     //     return if_type_expr;
     // free(if_type_expr);
 
-    Token* int_lit = parser_chomp_if(INTEGER);
-    if(int_lit != null) {
-        free(int_lit);
-        return ast_create_node(AstNodeKindIntLiteral);
+    TokenIndex int_lit = parser_chomp_if(INTEGER);
+    if(int_lit != TOKEN_NONE) {
+        return ast_create_node(parser, AstNodeKindIntLiteral, int_lit);
     }
     
-    Token* true_token = parser_chomp_if(TOK_TRUE);
-    if(true_token != null) {
-        free(true_token);
-        AstNode* out = ast_create_node(AstNodeKindBoolLiteral);
+    TokenIndex true_token = parser_chomp_if(TOK_TRUE);
+    if(true_token != TOKEN_NONE) {
+        AstNode* out = ast_create_node(parser, AstNodeKindBoolLiteral, true_token);
         out->data.comptime_value->bool_value->value = true;
         return out;
     }
 
-    Token* false_token = parser_chomp_if(TOK_TRUE);
-    if(false_token != null) {
-        free(false_token);
-        AstNode* out = ast_create_node(AstNodeKindBoolLiteral);
+    TokenIndex false_token = parser_chomp_if(TOK_TRUE);
+    if(false_token != TOKEN_NONE) {
+        AstNode* out = ast_create_node(parser, AstNodeKindBoolLiteral, false_token);
         out->data.comptime_value->bool_value->value = false;
         return out;
     }
 
-    Token* unreachable_token = parser_chomp_if(UNREACHABLE);
-    if(unreachable_token != null) {
-        free(unreachable_token);
-        return ast_create_node(AstNodeKindUnreachable);
+    TokenIndex unreachable_token = parser_chomp_if(UNREACHABLE);
+    if(unreachable_token != TOKEN_NONE) {
+        return ast_create_node(parser, AstNodeKindUnreachable, unreachable_token);
     }
 
-    Token* string_lit = parser_chomp_if(STRING);
-    if(string_lit != null) {
-        free(string_lit);
-        return ast_create_node(AstNodeKindStringLiteral);
+    TokenIndex string_lit = parser_chomp_if(STRING);
+    if(string_lit != TOKEN_NONE) {
+        return ast_create_node(parser, AstNodeKindStringLiteral, string_lit);
     }
 
     AstNode* match_token = ast_parse_match_expr(parser);
@@ -957,17 +1008,16 @@ static AstNode* ast_parse_primary_type_expr(Parser* parser) {
 }
 
 static Vec* ast_parse_branch_list(Parser* parser, AstNode* (*list_parser)(Parser* parser)) {
-    Vec* out = vec_new(AstNode, 1);
+    Vec* out = vec_new_in(parser->arena, AstNode, 1);
     while(true) {
         AstNode* curr = list_parser(parser);
         if(curr == null)
             break;
         
         vec_push(out, curr);
-        Token* sep = parser_chomp_if(COMMA);
-        if(sep == null)
+        TokenIndex sep = parser_chomp_if(COMMA);
+        if(sep == TOKEN_NONE)
             break;
-        free(sep);
     }
     return out;
 }
@@ -975,24 +1025,21 @@ static Vec* ast_parse_branch_list(Parser* parser, AstNode* (*list_parser)(Parser
 // MatchExpr
 //      KEYWORD(match) LPAREN? Expr RPAREN? LBRACE MatchBranchList RBRACE
 static AstNode* ast_parse_match_expr(Parser* parser) {
-    Token* match_token = parser_chomp_if(MATCH);
-    if(match_token == null)
+    TokenIndex match_token = parser_chomp_if(MATCH);
+    if(match_token == TOKEN_NONE)
         return null;
-    free(match_token);
 
     // Left and Right Parenthesis' here are optional
-    Token* lparen = parser_chomp_if(LPAREN);
+    TokenIndex lparen = parser_chomp_if(LPAREN);
     AstNode* expr = ast_parse_expr(parser);
-    Token* rparen = parser_chomp_if(RPAREN);
-    free(lparen);
-    free(rparen);
+    TokenIndex rparen = parser_chomp_if(RPAREN);
 
     // These *aren't* optional
-    Token* lbrace = parser_expect_token(LBRACE);
+    TokenIndex lbrace = parser_expect_token(LBRACE);
     Vec* branches = ast_parse_branch_list(parser,ast_parse_match_branch);
-    Token* rbrace = parser_expect_token(RBRACE);
+    TokenIndex rbrace = parser_expect_token(RBRACE);
 
-    AstNode* out = ast_create_node(AstNodeKindMatchExpr);
+    AstNode* out = ast_create_node(parser, AstNodeKindMatchExpr, match_token);
     out->data.expr->match_expr->expr = expr;
     out->data.expr->match_expr->branches = branches;
     return out;
@@ -1000,49 +1047,45 @@ static AstNode* ast_parse_match_expr(Parser* parser) {
 
 // BreakLabel
 //      COLON IDENTIFIER
-static Token* ast_parse_break_label(Parser* parser) {
-    Token* colon = parser_chomp_if(COLON);
-    if(colon == null) {
+static Buff* ast_parse_break_label(Parser* parser) {
+    TokenIndex colon = parser_chomp_if(COLON);
+    if(colon == TOKEN_NONE) {
         return null;
     }
-    free(colon);
-    Token* ident = parser_expect_token(IDENTIFIER);
-    return ident;
+    TokenIndex ident = parser_expect_token(IDENTIFIER);
+    return parser_token_value(parser, ident);
 }
 
 // BlockLabel
 //      IDENTIFIER COLON
-static Token* ast_parse_block_label(Parser* parser) {
-    Token* ident = parser_chomp_if(IDENTIFIER);
-    if(ident == null)
+static Buff* ast_parse_block_label(Parser* parser) {
+    TokenIndex ident = parser_chomp_if(IDENTIFIER);
+    if(ident == TOKEN_NONE)
         return null;
     
-    Token* colon = parser_chomp_if(COLON);
-    if(colon == null) {
-        free(ident);
-        return colon;
+    TokenIndex colon = parser_chomp_if(COLON);
+    if(colon == TOKEN_NONE) {
+        parser_put_back(parser);
+        return null;
     }
-    free(colon);
 
-    return ident;
+    return parser_token_value(parser, ident);
 }
 
 // MatchBranch
 //      KEYWORD(case) (COLON? / EQUALS_ARROW?) AssignmentExpr
 static AstNode* ast_parse_match_branch(Parser* parser) {
     AstNode* out = ast_parse_match_case_kwd(parser);
-    CORETEN_ENFORCE(out->kind == AstNodeKindMatchBranch);
     if(out == null)
         return null;
+    CORETEN_ENFORCE(out->kind == AstNodeKindMatchBranch);
     
-    Token* colon = parser_chomp_if(COLON); // `:`
-    Token* equals_arrow = parser_chomp_if(EQUALS_ARROW); // `=>`
-    if(colon == null && equals_arrow == null)
+    TokenIndex colon = parser_chomp_if(COLON); // `:`
+    TokenIndex equals_arrow = parser_chomp_if(EQUALS_ARROW); // `=>`
+    if(colon == TOKEN_NONE && equals_arrow == TOKEN_NONE)
         ast_error(
             "Missing token after `case`. Either `:` or `=>`"
         );
-    free(colon);
-    free(equals_arrow);
 
     AstNode* expr = ast_parse_assignment_expr(parser);
     out->data.expr->match_branch_expr->expr = expr;
@@ -1054,14 +1097,15 @@ static AstNode* ast_parse_match_branch(Parser* parser) {
 //      | MatchItem (COMMA MatchItem)* COMMA?
 //      | KEYWORD(else)
 static AstNode* ast_parse_match_case_kwd(Parser* parser) {
+    TokenIndex first = parser_peek_token(parser);
     AstNode* match_item = ast_parse_match_item(parser);
     if(match_item != null) {
-        AstNode* out = ast_create_node(AstNodeKindMatchBranch);
+        AstNode* out = ast_create_node(parser, AstNodeKindMatchBranch, first);
+        out->data.expr->match_branch_expr->branches = vec_new_in(parser->arena, AstNode, 1);
         vec_push(out->data.expr->match_branch_expr->branches, match_item);
 
-        Token* comma;
-        while((comma = parser_chomp_if(COMMA)) != null) {
-            free(comma);
+        TokenIndex comma;
+        while((comma = parser_chomp_if(COMMA)) != TOKEN_NONE) {
             AstNode* item = ast_parse_match_item(parser);
             if(item == null)
                 break;
@@ -1073,10 +1117,9 @@ static AstNode* ast_parse_match_case_kwd(Parser* parser) {
         return out;
     }
 
-    Token* else_kwd = parser_chomp_if(ELSE);
-    if(else_kwd != null) {
-        free(else_kwd);
-        AstNode* out = ast_create_node(AstNodeKindMatchBranch);
+    TokenIndex else_kwd = parser_chomp_if(ELSE);
+    if(else_kwd != TOKEN_NONE) {
+        AstNode* out = ast_create_node(parser, AstNodeKindMatchBranch, else_kwd);
         return out;
     }
 
@@ -1090,10 +1133,10 @@ static AstNode* ast_parse_match_item(Parser* parser) {
     if(expr == null)
         return null;
     
-    Token* ellipsis = parser_chomp_if(ELLIPSIS);
-    if(ellipsis != null) {
+    TokenIndex ellipsis = parser_chomp_if(ELLIPSIS);
+    if(ellipsis != TOKEN_NONE) {
         AstNode* expr2 = ast_parse_expr(parser);
-        AstNode* out = ast_create_node(AstNodeKindMatchRange);
+        AstNode* out = ast_create_node(parser, AstNodeKindMatchRange, ellipsis);
         out->data.expr->match_range_expr->begin = expr;
         out->data.expr->match_range_expr->end = expr2;
         return out;
@@ -1102,95 +1145,17 @@ static AstNode* ast_parse_match_item(Parser* parser) {
     return expr;
 }
 
-static AstNode* ast_parse_op(Parser* parser) {
-    BinaryOpKind op = tokenkind_to_binaryopkind( parser->curr_tok->kind);
-
-    if(op != BinaryOpKindInvalid) {
-        Token* op_token = parser_chomp(parser);
-        free(op_token);
-        AstNode* out = ast_create_node(AstNodeKindBinaryOpExpr);
-        out->data.expr->binary_op_expr->op = op;
-        return out;
-    }
-
-    return null;
-}
-
-// AssignmentOp can be one of:
-//      | PLUS_EQUALS
-//      | MINUS_EQUALS
-//      | MULT_EQUALS
-//      | SLASH_EQUALS
-//      | MOD_EQUALS
-//      | AND_EQUALS
-//      | OR_EQUALS 
-//      | XOR_EQUALS
-//      | LBITSHIFT_EQUALS
-//      | RBITSHIFT_EQUALS
-static AstNode* ast_parse_assignment_op(Parser* parser) {
-    return ast_parse_op(parser);
-}
-
-// ComparisonOp can be one of:
-//      | GREATER_THAN
-//      | LESS_THAN
-//      | GREATER_THAN_OR_EQUAL_TO
-//      | LESS_THAN_OR_EQUAL_TO
-//      | EQUALS_EQUALS
-//      | EXCLAMATION_EQUALS
-static AstNode* ast_parse_comparison_op(Parser* parser) {
-    return ast_parse_op(parser);
-}
-
-// BitwiseOp can be one of:
-//      | AND
-//      | OR
-//      | XOR
-static AstNode* ast_parse_bitwise_op(Parser* parser) {
-    return ast_parse_op(parser);
-}
-
-// BitshiftOp can be one of:
-//      | LBITSHIFT
-//      | RBITSHIFT
-static AstNode* ast_parse_bitshift_op(Parser* parser) {
-    return ast_parse_op(parser);
-}
-
-// AdditionOp can be one of:
-//      | PLUS
-//      | MINUS
-static AstNode* ast_parse_addition_op(Parser* parser) {
-    return ast_parse_op(parser);
-}
-
-// MultiplicationOp can be one of:
-//      | MULT
-//      | SLASH
-//      | MOD
-static AstNode* ast_parse_multiplication_op(Parser* parser) {
-    return ast_parse_op(parser);
-}
-
 // PrefixOp can be one of:
 //      | EXCLAMATION   (!)
 //      | TILDA         (~)
 //      | AND           (&)
 //      | KEYWORD(try) 
 static AstNode* ast_parse_prefix_op(Parser* parser) {
-    PrefixOpKind op;
-    switch(parser->curr_tok->kind) {
-        case NOT: op = PrefixOpKindBoolNot; break;
-        case EXCLAMATION: op = PrefixOpKindNegation; break;
-        case AND: op = PrefixOpKindAddrOf; break;
-        case TRY: op = PrefixOpKindTry; break;
-        default: op = PrefixOpKindInvalid; break;
-    }
+    PrefixOpKind op = cast(PrefixOpKind)parserPrefixOpKinds[parser_peek_kind(parser)];
 
     if(op != PrefixOpKindInvalid) {
-        Token* op_token = parser_chomp(parser);
-        free(op_token);
-        AstNode* out = ast_create_node(AstNodeKindPrefixOpExpr);
+        TokenIndex op_token = parser_chomp(parser);
+        AstNode* out = ast_create_node(parser, AstNodeKindPrefixOpExpr, op_token);
         out->data.prefix_op_expr->op = op;
         return out;
     }
@@ -1202,38 +1167,34 @@ static AstNode* ast_parse_prefix_op(Parser* parser) {
 //      | QUESTION
 //      | ArrayTypeStart (KEYWORD(const) / KEYWORD(volatile))*
 static AstNode* ast_parse_prefix_type_op(Parser* parser) {
-    Token* question_mark = parser_chomp_if(QUESTION);
-    if(question_mark != null) {
-        free(question_mark);
-        AstNode* out = ast_create_node(AstNodeKindPrefixOpExpr);
+    TokenIndex question_mark = parser_chomp_if(QUESTION);
+    if(question_mark != TOKEN_NONE) {
+        AstNode* out = ast_create_node(parser, AstNodeKindPrefixOpExpr, question_mark);
         out->data.prefix_op_expr->op = PrefixOpKindOptional;
         return out;
     }
 
-    Token* arr_init_lbrace = parser_chomp_if(LBRACE);
-    Buff* underscore_value = buff_new("_");
-    if(arr_init_lbrace != null) {
-        free(arr_init_lbrace);
-        Token* underscore = parser_chomp_if(IDENTIFIER);
-        if(underscore == null) {
+    TokenIndex arr_init_lbrace = parser_chomp_if(LBRACE);
+    if(arr_init_lbrace != TOKEN_NONE) {
+        TokenIndex underscore = parser_chomp_if(IDENTIFIER);
+        if(underscore == TOKEN_NONE) {
             parser_put_back(parser);
-        } else if(!buff_cmp(underscore->value, underscore_value)) {
+        } else if(!(pt->lens[TOKENLIST_SLOT(pt, underscore)] == 1 &&
+                    parser->lexer->buffer->data[pt->offsets[TOKENLIST_SLOT(pt, underscore)]] == '_')) {
             parser_put_back(parser);
             parser_put_back(parser);
         } else {
             AstNode* sentinel = null;
-            Token* colon = parser_chomp_if(COLON);
-            if(colon != null)
+            TokenIndex colon = parser_chomp_if(COLON);
+            if(colon != TOKEN_NONE)
                 sentinel = ast_parse_expr(parser);
             
-            Token* rbrace = parser_expect_token(RBRACE);
-            free(rbrace);
-            AstNode* out = ast_create_node(AstNodeKindArrayType);
+            TokenIndex rbrace = parser_expect_token(RBRACE);
+            AstNode* out = ast_create_node(parser, AstNodeKindArrayType, arr_init_lbrace);
             out->data.inferred_array_type->sentinel = sentinel;
             return out;
         }
     }
-    free(underscore_value);
 
     return null;
 }
@@ -1242,45 +1203,39 @@ static AstNode* ast_parse_prefix_type_op(Parser* parser) {
 //      | LBRACKET Expr (DOT2 (Expr (COLON Expr)?)?)? RBRACKET
 //      | DOT IDENTIFIER
 static AstNode* ast_parse_suffix_op(Parser* parser) {
-    Token* lbrace = parser_chomp_if(LBRACE);
-    if(lbrace != null) {
-        free(lbrace);
+    TokenIndex lbracket = parser_chomp_if(LSQUAREBRACK);
+    if(lbracket != TOKEN_NONE) {
         AstNode* lower = ast_parse_expr(parser);
         AstNode* upper = null;
-        Token* ellipsis = parser_chomp_if(ELLIPSIS);
-        if(ellipsis != null) {
-            free(ellipsis);
+        TokenIndex ellipsis = parser_chomp_if(ELLIPSIS);
+        if(ellipsis != TOKEN_NONE) {
             AstNode* sentinel = null;
             upper = ast_parse_expr(parser);
-            Token* colon = parser_chomp_if(COLON);
-            if(colon != null) {
-                free(colon);
+            TokenIndex colon = parser_chomp_if(COLON);
+            if(colon != TOKEN_NONE) {
                 sentinel = ast_parse_expr(parser);
             }
-            Token* rbrace = parser_expect_token(RBRACE);
-            free(rbrace);
+            TokenIndex rbracket = parser_expect_token(RSQUAREBRACK);
 
-            AstNode* out = ast_create_node(AstNodeKindSliceExpr);
+            AstNode* out = ast_create_node(parser, AstNodeKindSliceExpr, lbracket);
             out->data.expr->slice_expr->lower = lower;
             out->data.expr->slice_expr->upper = upper;
             out->data.expr->slice_expr->sentinel = sentinel;
             return out;
         }
 
-        Token* rbrace = parser_expect_token(RBRACE);
-        free(rbrace);
+        TokenIndex rbracket = parser_expect_token(RSQUAREBRACK);
 
-        AstNode* out = ast_create_node(AstNodeKindArrayAccessExpr);
+        AstNode* out = ast_create_node(parser, AstNodeKindArrayAccessExpr, lbracket);
         out->data.array_access_expr->subscript = lower;
         return out;
     }
 
-    Token* dot = parser_chomp_if(DOT);
-    if(dot != null) {
-        free(dot);
-        Token* identifier = parser_expect_token(IDENTIFIER);
-        AstNode* out = ast_create_node(AstNodeKindFieldAccessExpr);
-        out->data.field_access_expr->field_name = identifier->value;
+    TokenIndex dot = parser_chomp_if(DOT);
+    if(dot != TOKEN_NONE) {
+        Buff* field_name = parser_token_value(parser, parser_expect_token(IDENTIFIER));
+        AstNode* out = ast_create_node(parser, AstNodeKindFieldAccessExpr, dot);
+        out->data.field_access_expr->field_name = field_name;
         return out;
     }
 
@@ -1334,15 +1289,14 @@ static AstNode* ast_parse_prefix_op_expr(
 
 // FuncCallArguments
 static AstNode* ast_parse_func_call_args(Parser* parser) {
-    Token* lparen = parser_chomp_if(LPAREN);
-    if(lparen == null)
+    TokenIndex lparen = parser_chomp_if(LPAREN);
+    if(lparen == TOKEN_NONE)
         return null;
     
     Vec* params = ast_parse_param_list(parser, ast_parse_expr);
-    Token* rparen = parser_expect_token(RPAREN);
-    free(rparen);
+    TokenIndex rparen = parser_expect_token(RPAREN);
 
-    AstNode* out = ast_create_node(AstNodeKindFuncCallExpr);
+    AstNode* out = ast_create_node(parser, AstNodeKindFuncCallExpr, lparen);
     out->data.expr->func_call_expr->params = params;
     return out;
 }
@@ -25,10 +25,14 @@ typedef struct Parser {
     Buff* fullpath;     // path/to/file.ad
     Buff* basename;     // file.ad
     Lexer* lexer;
-    Vec* toklist;       // shortcut to `lexer->toklist`
-    Token* curr_tok;
+    TokenList* toklist; // shortcut to `lexer->toklist`
+    TokenIter iter;     // the current token
     UInt64 num_tokens;
     UInt64 num_lines;
+    UInt64 num_nodes;   // no. of nodes created by `ast_create_node()`
+    Arena* arena;       // the AST of this file: nodes, their payloads and small vectors (see `ast_create_node()`)
+    bool lazy_bodies;   // set by `parser_set_lazy_bodies()`
+    jmp_buf* recover;   // if set, `parser_error()` jumps here instead of exiting (used when parsing speculatively)
 
     // These are little hacks used during Parsing. This is expected to be removed in the future
     bool is_builtin_module;
@@ -36,6 +40,18 @@ typedef struct Parser {
 } Parser;
 
 Parser* parser_init(Lexer* lexer);
-AstNode* ast_create_node(AstNodeKind type);
+// Free the Parser along with the AST it produced. To keep the AST of a module (made of several files) around instead,
+// move it into the module's Arena with `arena_merge()` first
+void parser_free(Parser* parser);
+// Report a syntax error. Jumps to `parser->recover` if it is set, and exits otherwise
+void parser_error(Parser* parser, Error err, const char* format, ...);
+// Skip function bodies while parsing: a prototype only records the token range of its `{ ... }` body, which is parsed
+// by `parser_parse_body()` when a later phase needs it. Ignored for a streaming Lexer (its tokens can't be revisited)
+void parser_set_lazy_bodies(Parser* parser, bool lazy);
+// Returns the body of a function prototype, parsing it first if it was skipped (null if the function has no body)
+AstNode* parser_parse_body(Parser* parser, AstNode* func);
+// Allocate a (zeroed) node of `kind` and its payload from `parser->arena`. `main_token` is the token the node is
+// anchored to (see the table above `FlatAst`)
+AstNode* ast_create_node(Parser* parser, AstNodeKind kind, TokenIndex main_token);
 
 #endif // ADORAD_PARSER_H
\ No newline at end of file
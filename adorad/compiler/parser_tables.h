@@ -0,0 +1,154 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+
+// Auto-generated by tools/scripts/generate_tokens.py from `ALLTOKENS` (adorad/compiler/tokens.h). Do not edit.
+// Regenerate with: python3 tools/scripts/generate_tokens.py parser_tables
+// NB: This is only meant to be included by `parser.c` (after `AstAssoc`)
+#ifndef ADORAD_PARSER_TABLES_H
+#define ADORAD_PARSER_TABLES_H
+
+// Generated for this many TokenKinds: regenerate the tables if this fails
+CORETEN_STATIC_ASSERT(TOK_COUNT == 164);
+
+// Precedence of the assignment operators, which bind the loosest (and aren't part of an `Expr`)
+#define PARSER_PREC_ASSIGNMENT  5
+
+// Precedence of each binary operator (0 unless the token is one). Higher precedence numbers are stickier.
+static const UInt8 parserPrecedence[TOK_COUNT] = {
+    [MULT]                     = 60,
+    [MOD]                      = 60,
+    [SLASH]                    = 60,
+    [PLUS]                     = 50,
+    [MINUS]                    = 50,
+    [LBITSHIFT]                = 40,
+    [RBITSHIFT]                = 40,
+    [AND]                      = 35,
+    [XOR]                      = 35,
+    [OR]                       = 35,
+    [EQUALS_EQUALS]            = 30,
+    [EXCLAMATION_EQUALS]       = 30,
+    [GREATER_THAN]             = 30,
+    [LESS_THAN]                = 30,
+    [GREATER_THAN_OR_EQUAL_TO] = 30,
+    [LESS_THAN_OR_EQUAL_TO]    = 30,
+    [AND_AND]                  = 20,
+    [OR_OR]                    = 10,
+    [EQUALS]                   = 5,
+    [PLUS_EQUALS]              = 5,
+    [MINUS_EQUALS]             = 5,
+    [MULT_EQUALS]              = 5,
+    [SLASH_EQUALS]             = 5,
+    [MOD_EQUALS]               = 5,
+    [AND_EQUALS]               = 5,
+    [OR_EQUALS]                = 5,
+    [XOR_EQUALS]               = 5,
+    [LBITSHIFT_EQUALS]         = 5,
+    [RBITSHIFT_EQUALS]         = 5,
+};
+
+// How each binary operator groups with the operators of the same precedence (AstAssoc)
+static const UInt8 parserAssoc[TOK_COUNT] = {
+    [MULT]                     = AstAssocLeft,
+    [MOD]                      = AstAssocLeft,
+    [SLASH]                    = AstAssocLeft,
+    [PLUS]                     = AstAssocLeft,
+    [MINUS]                    = AstAssocLeft,
+    [LBITSHIFT]                = AstAssocLeft,
+    [RBITSHIFT]                = AstAssocLeft,
+    [AND]                      = AstAssocLeft,
+    [XOR]                      = AstAssocLeft,
+    [OR]                       = AstAssocLeft,
+    [EQUALS_EQUALS]            = AstAssocNone,
+    [EXCLAMATION_EQUALS]       = AstAssocNone,
+    [GREATER_THAN]             = AstAssocNone,
+    [LESS_THAN]                = AstAssocNone,
+    [GREATER_THAN_OR_EQUAL_TO] = AstAssocNone,
+    [LESS_THAN_OR_EQUAL_TO]    = AstAssocNone,
+    [AND_AND]                  = AstAssocLeft,
+    [OR_OR]                    = AstAssocLeft,
+    [EQUALS]                   = AstAssocRight,
+    [PLUS_EQUALS]              = AstAssocRight,
+    [MINUS_EQUALS]             = AstAssocRight,
+    [MULT_EQUALS]              = AstAssocRight,
+    [SLASH_EQUALS]             = AstAssocRight,
+    [MOD_EQUALS]               = AstAssocRight,
+    [AND_EQUALS]               = AstAssocRight,
+    [OR_EQUALS]                = AstAssocRight,
+    [XOR_EQUALS]               = AstAssocRight,
+    [LBITSHIFT_EQUALS]         = AstAssocRight,
+    [RBITSHIFT_EQUALS]         = AstAssocRight,
+};
+
+// BinaryOpKind of each binary operator (BinaryOpKindInvalid unless the token is one)
+static const UInt8 parserBinaryOpKinds[TOK_COUNT] = {
+    [MULT]                     = BinaryOpKindMult,
+    [MOD]                      = BinaryOpKindMod,
+    [SLASH]                    = BinaryOpKindDiv,
+    [PLUS]                     = BinaryOpKindAdd,
+    [MINUS]                    = BinaryOpKindSubtract,
+    [LBITSHIFT]                = BinaryOpKindBitshitLeft,
+    [RBITSHIFT]                = BinaryOpKindBitshitRight,
+    [AND]                      = BinaryOpKindBitAnd,
+    [XOR]                      = BinaryOpKindBitXor,
+    [OR]                       = BinaryOpKindBitOr,
+    [EQUALS_EQUALS]            = BinaryOpKindCmpEqual,
+    [EXCLAMATION_EQUALS]       = BinaryOpKindCmpNotEqual,
+    [GREATER_THAN]             = BinaryOpKindCmpGreaterThan,
+    [LESS_THAN]                = BinaryOpKindCmpLessThan,
+    [GREATER_THAN_OR_EQUAL_TO] = BinaryOpKindCmpGreaterThanorEqualTo,
+    [LESS_THAN_OR_EQUAL_TO]    = BinaryOpKindCmpLessThanorEqualTo,
+    [AND_AND]                  = BinaryOpKindBoolAnd,
+    [OR_OR]                    = BinaryOpKindBoolOr,
+    [EQUALS]                   = BinaryOpKindAssignmentEquals,
+    [PLUS_EQUALS]              = BinaryOpKindAssignmentPlus,
+    [MINUS_EQUALS]             = BinaryOpKindAssignmentMinus,
+    [MULT_EQUALS]              = BinaryOpKindAssignmentMult,
+    [SLASH_EQUALS]             = BinaryOpKindAssignmentDiv,
+    [MOD_EQUALS]               = BinaryOpKindAssignmentMod,
+    [AND_EQUALS]               = BinaryOpKindAssignmentBitAnd,
+    [OR_EQUALS]                = BinaryOpKindAssignmentBitOr,
+    [XOR_EQUALS]               = BinaryOpKindAssignmentBitXor,
+    [LBITSHIFT_EQUALS]         = BinaryOpKindAssignmentBitshiftLeft,
+    [RBITSHIFT_EQUALS]         = BinaryOpKindAssignmentBitshiftRight,
+};
+
+// PrefixOpKind of each prefix operator (PrefixOpKindInvalid unless the token is one)
+static const UInt8 parserPrefixOpKinds[TOK_COUNT] = {
+    [NOT]                      = PrefixOpKindBoolNot,
+    [EXCLAMATION]              = PrefixOpKindNegation,
+    [AND]                      = PrefixOpKindAddrOf,
+    [TRY]                      = PrefixOpKindTry,
+};
+
+// Set for the assignment operators
+static const bool parserIsAssignmentOp[TOK_COUNT] = {
+    [EQUALS]                   = true,
+    [PLUS_EQUALS]              = true,
+    [MINUS_EQUALS]             = true,
+    [MULT_EQUALS]              = true,
+    [SLASH_EQUALS]             = true,
+    [MOD_EQUALS]               = true,
+    [AND_EQUALS]               = true,
+    [OR_EQUALS]                = true,
+    [XOR_EQUALS]               = true,
+    [LBITSHIFT_EQUALS]         = true,
+    [RBITSHIFT_EQUALS]         = true,
+};
+
+CORETEN_STATIC_ASSERT(sizeof(parserPrecedence) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(sizeof(parserAssoc) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(sizeof(parserBinaryOpKinds) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(sizeof(parserPrefixOpKinds) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(BinaryOpKindInvalid == 0 && PrefixOpKindInvalid == 0);
+
+#endif // ADORAD_PARSER_TABLES_H
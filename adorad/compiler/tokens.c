@@ -12,6 +12,8 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 */
 
 #include <stdlib.h>
+#include <string.h>
+#include <adorad/core/debug.h>
 #include <adorad/compiler/tokens.h>
 
 // Token constructor
@@ -19,8 +21,8 @@ Token* token_init() {
     Token* token = cast(Token*)calloc(1, sizeof(Token));
     token->kind = TOK_ILLEGAL;
     token->offset = 0;
-    token->value = buff_new(null);
-    token->loc = loc_new(null);
+    token->len = 0;
+    token->atom = ATOM_NONE;
 
     return token;
 }
@@ -29,8 +31,8 @@ Token* token_init() {
 void token_reset_token(Token* token) {
     token->kind = TOK_ILLEGAL; 
     token->offset = 0; 
-    buff_set(token->value, "");
-    loc_reset(token->loc);
+    token->len = 0;
+    token->atom = ATOM_NONE;
 }
 
 // Convert a Token to its respective String representation
@@ -141,7 +143,7 @@ Buff* token_to_buff(TokenKind kind) {
         case COLON: value = ":"; break;
         case COLON_COLON: value = "::"; break;
         case SEMICOLON: value = ";"; break;
-        case COMMA: value = ":"; break;
+        case COMMA: value = ","; break;
         case DOT: value = "."; break;
         case DDOT: value = ".."; break;
         case ELLIPSIS: value = "..."; break;
@@ -206,4 +208,164 @@ Buff* token_to_buff(TokenKind kind) {
 
     buff_set(buf, value);
     return buf;
-}
\ No newline at end of file
+}
+// Create a new TokenList with space for `cap` tokens
+TokenList* tokenlist_new(UInt32 cap) {
+    if(cap == 0)
+        cap = 1;
+
+    TokenList* list = cast(TokenList*)calloc(1, sizeof(TokenList));
+    CORETEN_ENFORCE_NN(list, "Could not allocate memory. Memory full.");
+    list->kinds = cast(UInt8*)malloc(cap * sizeof(UInt8));
+    list->offsets = cast(UInt32*)malloc(cap * sizeof(UInt32));
+    list->lens = cast(UInt32*)malloc(cap * sizeof(UInt32));
+    list->atoms = cast(Atom*)malloc(cap * sizeof(Atom));
+    CORETEN_ENFORCE(list->kinds && list->offsets && list->lens && list->atoms, "Could not allocate memory. Memory full.");
+    list->size = 0;
+    list->cap = cap;
+    list->base = 0;
+    list->mask = TOKENLIST_NO_MASK;
+
+    return list;
+}
+
+// Create a ring TokenList that holds (at least) the last `window` tokens pushed
+// Once the ring is full, pushing a token drops the oldest one, so memory stays constant however many tokens pass
+// through it.
+TokenList* tokenlist_new_ring(UInt32 window) {
+    // Round up to a power of 2 so that a token's slot is `index & mask`
+    UInt32 cap = 1;
+    while(cap < window)
+        cap <<= 1;
+
+    TokenList* list = tokenlist_new(cap);
+    list->mask = cap - 1;
+    return list;
+}
+
+// Free a TokenList
+void tokenlist_free(TokenList* list) {
+    if(list) {
+        free(list->kinds);
+        free(list->offsets);
+        free(list->lens);
+        free(list->atoms);
+        free(list);
+    }
+}
+
+// Resize the arrays of the TokenList to hold `cap` tokens
+static void tokenlist_resize(TokenList* list, UInt32 cap) {
+    list->kinds = cast(UInt8*)realloc(list->kinds, cap * sizeof(UInt8));
+    list->offsets = cast(UInt32*)realloc(list->offsets, cap * sizeof(UInt32));
+    list->lens = cast(UInt32*)realloc(list->lens, cap * sizeof(UInt32));
+    list->atoms = cast(Atom*)realloc(list->atoms, cap * sizeof(Atom));
+    CORETEN_ENFORCE(list->kinds && list->offsets && list->lens && list->atoms, "Could not allocate memory. Memory full.");
+    list->cap = cap;
+}
+
+// Grow the TokenList (by a factor of 2)
+static inline void tokenlist_grow(TokenList* list) {
+    tokenlist_resize(list, list->cap * 2);
+}
+
+// Make room for (at least) `cap` tokens in the TokenList
+void tokenlist_reserve(TokenList* list, UInt32 cap) {
+    CORETEN_ENFORCE(list->mask == TOKENLIST_NO_MASK, "Cannot resize a ring TokenList");
+    if(cap > list->cap)
+        tokenlist_resize(list, cap);
+}
+
+// Append a token to the TokenList (growing it if required)
+void tokenlist_push(TokenList* list, TokenKind kind, UInt32 offset, UInt32 len, Atom atom) {
+    if(list->size - list->base == list->cap) {
+        // A ring never grows - the oldest token is dropped instead
+        if(list->mask == TOKENLIST_NO_MASK)
+            tokenlist_grow(list);
+        else
+            list->base++;
+    }
+
+    UInt32 slot = TOKENLIST_SLOT(list, list->size);
+    list->kinds[slot] = cast(UInt8)kind;
+    list->offsets[slot] = offset;
+    list->lens[slot] = len;
+    list->atoms[slot] = atom;
+    list->size++;
+}
+
+// Returns the `index`th token in the TokenList
+Token tokenlist_at(TokenList* list, TokenIndex index) {
+    CORETEN_ENFORCE(index >= list->base && index < list->size, "TokenList index out of bounds");
+
+    UInt32 slot = TOKENLIST_SLOT(list, index);
+    Token token;
+    token.kind = cast(TokenKind)list->kinds[slot];
+    token.offset = list->offsets[slot];
+    token.len = list->lens[slot];
+    token.atom = list->atoms[slot];
+    return token;
+}
+
+// Replace the tokens [begin, end) of `list` with the tokens of `with`
+// The offsets of the tokens that follow are shifted by `shift` bytes (the change in length of the Lexical buffer).
+void tokenlist_splice(TokenList* list, TokenIndex begin, TokenIndex end, TokenList* with, Int64 shift) {
+    CORETEN_ENFORCE(begin <= end && end <= list->size, "TokenList splice out of bounds");
+    CORETEN_ENFORCE(list->mask == TOKENLIST_NO_MASK, "Cannot splice a ring TokenList");
+
+    UInt32 tail = list->size - end;
+    UInt32 size = begin + with->size + tail;
+    while(list->cap < size)
+        tokenlist_grow(list);
+
+    // Move the tail into place, then copy `with` into the gap
+    UInt32 dest = begin + with->size;
+    memmove(list->kinds + dest, list->kinds + end, tail * sizeof(UInt8));
+    memmove(list->offsets + dest, list->offsets + end, tail * sizeof(UInt32));
+    memmove(list->lens + dest, list->lens + end, tail * sizeof(UInt32));
+    memmove(list->atoms + dest, list->atoms + end, tail * sizeof(Atom));
+    memcpy(list->kinds + begin, with->kinds, with->size * sizeof(UInt8));
+    memcpy(list->offsets + begin, with->offsets, with->size * sizeof(UInt32));
+    memcpy(list->lens + begin, with->lens, with->size * sizeof(UInt32));
+    memcpy(list->atoms + begin, with->atoms, with->size * sizeof(Atom));
+
+    for(UInt32 i = dest; i < size; i++)
+        list->offsets[i] = cast(UInt32)(list->offsets[i] + shift);
+    list->size = size;
+}
+
+// Create an iterator over `list`, beginning at the first token
+TokenIter tokeniter_new(TokenList* list) {
+    TokenIter iter;
+    iter.list = list;
+    iter.index = list->base;
+    return iter;
+}
+
+// Returns the kind of the current token (TOK_EOF once the list is exhausted)
+TokenKind tokeniter_peek(TokenIter* iter) {
+    if(iter->index >= iter->list->size)
+        return TOK_EOF;
+    return cast(TokenKind)iter->list->kinds[TOKENLIST_SLOT(iter->list, iter->index)];
+}
+
+// Returns the kind of the token `n` tokens ahead of the current one (TOK_EOF if that is past the end)
+TokenKind tokeniter_peekn(TokenIter* iter, UInt32 n) {
+    if(iter->index + n >= iter->list->size)
+        return TOK_EOF;
+    return cast(TokenKind)iter->list->kinds[TOKENLIST_SLOT(iter->list, iter->index + n)];
+}
+
+// Consumes the current token and returns its index
+TokenIndex tokeniter_next(TokenIter* iter) {
+    return iter->index++;
+}
+
+// Steps back a single token
+// For a ring TokenList, this only works as long as the previous token is still held.
+void tokeniter_put_back(TokenIter* iter) {
+    if(iter->index > 0) {
+        CORETEN_ENFORCE(iter->index > iter->list->base, "Cannot put back a token that has left the TokenList window");
+        iter->index--;
+    }
+}
@@ -17,6 +17,7 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 #include <adorad/core/misc.h>
 #include <adorad/core/types.h> 
 #include <adorad/compiler/location.h>
+#include <adorad/compiler/interner.h>
 
 /*
     `tokens.h` defines constants representing the lexical tokens of the Adorad programming language and basic operations
@@ -24,7 +25,8 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 
     NOTE: 
     Any changes made to this function _MUST_ be reflect in the token_to_buff() (in <adorad/compiler/tokens.c>)
-    as well as in Syntax.toml (adorad/compiler/syntax/syntax.toml)
+    as well as in Syntax.toml (adorad/compiler/syntax/syntax.toml), and the Lexer's and Parser's tables must be
+    regenerated (`python3 tools/scripts/generate_tokens.py lexer_tables` and `... parser_tables`)
 */
 #define ALLTOKENS \
     /* Special (internal usage only) */ \
@@ -220,15 +222,53 @@ typedef enum TokenKind {
     #undef TOKENKIND
 } TokenKind;
 
+// TokenKinds are stored as a single byte in a `TokenList`
+CORETEN_STATIC_ASSERT(TOK_COUNT <= 256);
+
 // Main Token Struct 
+// A Token does not own its value. It is simply a view (`offset`, `len`) into the Lexical buffer it was lexed from,
+// so no memory is allocated per token. Use `lexer_token_value()` if an owned copy of the value is required.
+// Tokens are not stored in this form (see `TokenList`) - a `Token` is simply an unpacked view of a single entry.
 typedef struct Token {
     TokenKind kind;     // Token Kind
-    UInt32 offset;      // Offset of the first character of the Token
-    Buff* value;        // Token value
-    UInt32 start;       // Starting offset of the token (used in substring-ing tokens of length >1)
-    Location* loc;      // location of the token in the source code
+    UInt32 offset;      // Offset of the first character of the Token (in the Lexical buffer)
+    UInt32 len;         // Length of the Token value (in Bytes)
+    Atom atom;          // Atom of an IDENTIFIER or a MACRO (ATOM_NONE for every other token)
 } Token;
 
+// Index of a token in a `TokenList`
+typedef UInt32 TokenIndex;
+// Returned in place of a TokenIndex when there is no token (e.g. `parser_chomp_if()` doesn't match)
+#define TOKEN_NONE      cast(TokenIndex)(-1)
+
+// Packed token store
+// Tokens are stored as parallel arrays (a struct-of-arrays) so that a token costs 13 bytes (kind + offset + len +
+// atom) and walking the kinds linearly (which is what the Parser does) touches a single dense byte array.
+//
+// A TokenList can also be a fixed-size ring (see `tokenlist_new_ring()`), used when streaming tokens. A ring holds
+// only the last `cap` tokens pushed: indices stay absolute, and token `i` lives in slot `i & mask`.
+typedef struct TokenList {
+    UInt8* kinds;       // TokenKind of each token
+    UInt32* offsets;    // offset of the first character of each token (in the Lexical buffer)
+    UInt32* lens;       // length of each token value (in Bytes)
+    Atom* atoms;        // Atom of each token (see `Token`)
+    UInt32 size;        // number of tokens (pushed so far, for a ring)
+    UInt32 cap;         // number of tokens allocated for
+    UInt32 base;        // index of the oldest token still held (always 0 unless this is a ring)
+    UInt32 mask;        // maps a token index to its slot (TOKENLIST_NO_MASK unless this is a ring)
+} TokenList;
+
+#define TOKENLIST_NO_MASK   cast(UInt32)(-1)
+
+// Slot of token `index` in the arrays of `list`
+#define TOKENLIST_SLOT(list, index)     ((index) & (list)->mask)
+
+// A cursor over a `TokenList`
+typedef struct TokenIter {
+    TokenList* list;
+    TokenIndex index;   // index of the current token
+} TokenIter;
+
 // Create a basic (ILLEGAL) token
 Token* token_init();
 // Reset a Token instance
@@ -236,4 +276,30 @@ void token_reset_token(Token* token);
 // Convert a Token to its respective String representation
 Buff* token_to_buff(TokenKind kind);
 
+// Create a new TokenList with space for `cap` tokens
+TokenList* tokenlist_new(UInt32 cap);
+// Create a ring TokenList that holds (at least) the last `window` tokens pushed
+TokenList* tokenlist_new_ring(UInt32 window);
+// Free a TokenList
+void tokenlist_free(TokenList* list);
+// Make room for (at least) `cap` tokens in the TokenList, so that pushing that many doesn't grow it
+void tokenlist_reserve(TokenList* list, UInt32 cap);
+// Append a token to the TokenList (growing it if required)
+void tokenlist_push(TokenList* list, TokenKind kind, UInt32 offset, UInt32 len, Atom atom);
+// Returns the `index`th token in the TokenList
+Token tokenlist_at(TokenList* list, TokenIndex index);
+// Replace the tokens [begin, end) with the tokens of `with`, shifting the offsets of the tokens after them by `shift`
+void tokenlist_splice(TokenList* list, TokenIndex begin, TokenIndex end, TokenList* with, Int64 shift);
+
+// Create an iterator over `list`, beginning at the first token
+TokenIter tokeniter_new(TokenList* list);
+// Returns the kind of the current token (TOK_EOF once the list is exhausted)
+TokenKind tokeniter_peek(TokenIter* iter);
+// Returns the kind of the token `n` tokens ahead of the current one (TOK_EOF if that is past the end)
+TokenKind tokeniter_peekn(TokenIter* iter, UInt32 n);
+// Consumes the current token and returns its index
+TokenIndex tokeniter_next(TokenIter* iter);
+// Steps back a single token
+void tokeniter_put_back(TokenIter* iter);
+
 #endif // ADORAD_TOKEN_H
\ No newline at end of file
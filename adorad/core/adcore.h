@@ -63,7 +63,9 @@ CREDITS
 #include <adorad/core/misc.h>
 #include <adorad/core/io.h>
 #include <adorad/core/memory.h>
+#include <adorad/core/arena.h>
 #include <adorad/core/math.h>
+#include <adorad/core/number.h>
 #include <adorad/core/os.h>
 #include <adorad/core/buffer.h>
 #include <adorad/core/char.h>
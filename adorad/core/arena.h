@@ -0,0 +1,45 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+
+#ifndef CORETEN_ARENA_H
+#define CORETEN_ARENA_H
+
+#include <adorad/core/types.h>
+
+// Allocations are carved out of blocks of (at least) this size
+#define ARENA_DEFAULT_BLOCK_SIZE    (64 * 1024)
+
+// An Arena (bump allocator) hands out memory from large blocks, and frees all of it at once (`arena_free()`).
+// There is no way to free an individual allocation.
+typedef struct cstlArenaBlock {
+    struct cstlArenaBlock* prev;  // the previously filled block
+    UInt64 used;                  // no. of bytes handed out from `data`
+    UInt64 cap;                   // size of `data` (in bytes)
+    char data[];
+} cstlArenaBlock;
+
+typedef struct cstlArena cstlArena;
+typedef cstlArena Arena;
+struct cstlArena {
+    cstlArenaBlock* head;         // the block allocations are currently served from
+    UInt64 block_size;            // size of a new block
+};
+
+cstlArena* arena_new(UInt64 block_size);
+void arena_free(cstlArena* arena);
+// Allocate `size` bytes aligned to `align` (a power of 2). The memory is not zeroed.
+void* arena_alloc(cstlArena* arena, UInt64 size, UInt64 align);
+// Move every block of `other` into `arena` (allocations from `other` remain valid), and free `other`
+void arena_merge(cstlArena* arena, cstlArena* other);
+
+#endif // CORETEN_ARENA_H
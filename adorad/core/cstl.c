@@ -18,6 +18,12 @@ CREDITS
     Written by Jason Dsouza <@jasmcaus>
 */
 
+// `file_map()` needs the (non-ISO) extensions of <sys/mman.h>. These must be requested before any system header is
+// included
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE
+#endif
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -25,6 +31,80 @@ CREDITS
 
 #include <adorad/core/adcore.h>
 
+#if defined(CORETEN_OS_UNIX)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif // CORETEN_OS_UNIX
+
+// -------------------------------------------------------------------------
+// arena.c
+// -------------------------------------------------------------------------
+
+// Create a new Arena. Blocks are allocated lazily, so an Arena that is never used costs nothing.
+cstlArena* arena_new(UInt64 block_size) {
+    cstlArena* arena = cast(cstlArena*)calloc(1, sizeof(cstlArena));
+    CORETEN_ENFORCE_NN(arena, "Could not allocate memory. Memory full.");
+    arena->block_size = block_size > 0 ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+    return arena;
+}
+
+void arena_free(cstlArena* arena) {
+    if(!arena)
+        return;
+    cstlArenaBlock* block = arena->head;
+    while(block) {
+        cstlArenaBlock* prev = block->prev;
+        free(block);
+        block = prev;
+    }
+    free(arena);
+}
+
+void* arena_alloc(cstlArena* arena, UInt64 size, UInt64 align) {
+    CORETEN_ENFORCE_NN(arena, "Expected not null");
+    CORETEN_ENFORCE(align > 0 && (align & (align - 1)) == 0, "Alignment must be a power of 2");
+
+    cstlArenaBlock* block = arena->head;
+    if(block) {
+        UInt64 begin = (cast(UInt64)(UIntptr)(block->data + block->used) + align - 1) & ~(align - 1);
+        UInt64 offset = begin - cast(UInt64)(UIntptr)block->data;
+        if(offset + size <= block->cap) {
+            block->used = offset + size;
+            return block->data + offset;
+        }
+    }
+
+    // Start a new block (an allocation larger than a block gets a block of its own)
+    UInt64 cap = size + align > arena->block_size ? size + align : arena->block_size;
+    cstlArenaBlock* fresh = cast(cstlArenaBlock*)malloc(sizeof(cstlArenaBlock) + cap);
+    CORETEN_ENFORCE_NN(fresh, "Could not allocate memory. Memory full.");
+    fresh->prev = block;
+    fresh->used = 0;
+    fresh->cap = cap;
+    arena->head = fresh;
+    return arena_alloc(arena, size, align);
+}
+
+void arena_merge(cstlArena* arena, cstlArena* other) {
+    CORETEN_ENFORCE_NN(arena, "Expected not null");
+    if(!other)
+        return;
+    if(other->head) {
+        // Chain `other`'s blocks behind `arena`'s current block, so that allocations continue from the latter
+        cstlArenaBlock* last = other->head;
+        while(last->prev)
+            last = last->prev;
+        if(arena->head) {
+            last->prev = arena->head->prev;
+            arena->head->prev = other->head;
+        } else {
+            arena->head = other->head;
+        }
+    }
+    free(other);
+}
+
 // -------------------------------------------------------------------------
 // buffer.c
 // -------------------------------------------------------------------------
@@ -893,11 +973,12 @@ UInt64 hash_murmur64_seed(void const* data__, Ll len, UInt64 seed) {
     UInt64 h = seed ^ (len * m);
 
     UInt64 const* data = cast(UInt64 const* )data__;
-    UInt8  const* data2 = cast(UInt8 const* )data__;
     UInt64 const* end = data + (len / 8);
 
     while(data != end) {
-        UInt64 k = *data++;
+        // `data__` needn't be 8-byte aligned
+        UInt64 k;
+        memcpy(&k, data++, sizeof(k));
 
         k *= m;
         k ^= k >> r;
@@ -907,6 +988,9 @@ UInt64 hash_murmur64_seed(void const* data__, Ll len, UInt64 seed) {
         h *= m;
     }
 
+    // The remaining (`len % 8`) bytes
+    UInt8 const* data2 = cast(UInt8 const* )data;
+
     // Fallthrough intended
     CORETEN_GCC_SUPPRESS_WARNING_PUSH
     CORETEN_CLANG_SUPPRESS_WARNING_PUSH
@@ -1002,15 +1086,18 @@ UInt64 hash_murmur64_seed(void const* data__, Ll len, UInt64 seed) {
 // io.h
 // -------------------------------------------------------------------------
 
+static void __io_open_failed(const char* fname) {
+    cstlColouredPrintf(CORETEN_COLOUR_ERROR, "Could not open file: <%s>\n", fname);
+    cstlColouredPrintf(CORETEN_COLOUR_ERROR, "%s\n", !file_exists(fname) ?  
+                        "FileNotFoundError: File does not exist." : "");
+    exit(1);
+}
+
 char* readFile(const char* fname) {
     FILE* file = fopen(fname, "rb"); 
     
-    if(!file) {
-        cstlColouredPrintf(CORETEN_COLOUR_ERROR, "Could not open file: <%s>\n", fname);
-        cstlColouredPrintf(CORETEN_COLOUR_ERROR, "%s\n", !file_exists(fname) ?  
-                            "FileNotFoundError: File does not exist." : "");
-        exit(1);
-    }
+    if(!file)
+        __io_open_failed(fname);
 
     // Get the length of the input buffer
     fseek(file, 0, SEEK_END); 
@@ -1030,6 +1117,108 @@ char* readFile(const char* fname) {
     return buffer;
 }
 
+// Read `file` until EOF into a (NUL-terminated) heap buffer. Unlike `readFile()`, this doesn't need to know the
+// length upfront, so it works for pipes as well
+static char* __io_read_stream(FILE* file, UInt64* len) {
+    UInt64 cap = 64 * 1024;
+    UInt64 size = 0;
+    char* buffer = cast(char*)malloc(cap);
+    CORETEN_ENFORCE_NN(buffer, "Could not allocate memory. Memory full.");
+
+    for(;;) {
+        size += fread(buffer + size, 1, cap - size - 1, file);
+        if(size < cap - 1)
+            break;
+        cap *= 2;
+        buffer = cast(char*)realloc(buffer, cap);
+        CORETEN_ENFORCE_NN(buffer, "Could not allocate memory. Memory full.");
+    }
+    buffer[size] = nullchar;
+    *len = size;
+    return buffer;
+}
+
+// Map the file `fname` into memory (read-only), so that it isn't copied from the page cache into the heap.
+// The contents are always followed by a `\0`. Files that can't be mapped (pipes, character devices, empty files, ...)
+// are read into the heap instead. Returns null if the file can't be opened or read.
+FileMap* file_try_map(const char* fname) {
+    FileMap* map = cast(FileMap*)calloc(1, sizeof(FileMap));
+    CORETEN_ENFORCE_NN(map, "Could not allocate memory. Memory full.");
+
+#if defined(CORETEN_OS_UNIX)
+    int fd = open(fname, O_RDONLY);
+    if(fd < 0) {
+        free(map);
+        return null;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        UInt64 len = cast(UInt64)st.st_size;
+        UInt64 page = cast(UInt64)sysconf(_SC_PAGESIZE);
+        // Reserve at least one byte more than the file needs. The bytes past the end of the file in its last page
+        // read as zero, and if the file ends on a page boundary, the (anonymous) page after it is all zeroes.
+        UInt64 mapped_len = (len / page + 1) * page;
+        char* region = cast(char*)mmap(null, mapped_len, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(region != MAP_FAILED) {
+            if(mmap(region, len, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) != MAP_FAILED) {
+                // Source files are read front to back (once)
+                madvise(region, len, MADV_SEQUENTIAL);
+                close(fd);
+                map->contents = region;
+                map->len = len;
+                map->mapped_len = mapped_len;
+                return map;
+            }
+            munmap(region, mapped_len);
+        }
+    }
+
+    FILE* file = fdopen(fd, "rb");
+    if(!file)
+        close(fd);
+#else
+    FILE* file = fopen(fname, "rb");
+#endif // CORETEN_OS_UNIX
+    if(!file) {
+        free(map);
+        return null;
+    }
+    map->contents = __io_read_stream(file, &map->len);
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    if(failed) {
+        free(map->contents);
+        free(map);
+        return null;
+    }
+    return map;
+}
+
+// Like `file_try_map()`, but exits if the file can't be opened or read
+FileMap* file_map(const char* fname) {
+    FileMap* map = file_try_map(fname);
+    if(!map)
+        __io_open_failed(fname);
+    return map;
+}
+
+// Release a file returned by `file_map()`
+void file_unmap(FileMap* map) {
+    if(!map)
+        return;
+
+#if defined(CORETEN_OS_UNIX)
+    if(map->mapped_len) {
+        munmap(map->contents, map->mapped_len);
+        free(map);
+        return;
+    }
+#endif // CORETEN_OS_UNIX
+    free(map->contents);
+    free(map);
+}
+
 bool file_exists(const char* path) {
 #ifdef WIN32
     if (GetFileAttributesA(path) != INVALID_FILE_ATTRIBUTES) return true;
@@ -1159,6 +1348,313 @@ Float32 coreten_log2(Float32 x){
     return coreten_log(x) / CORETEN_MATH_LOG_TWO;
 }
 
+// -------------------------------------------------------------------------
+// number.h
+// -------------------------------------------------------------------------
+
+#include <adorad/core/number_data.h>
+
+// The decimal value of a float literal: `mantissa * 10^exp10`
+typedef struct NumberDecimal {
+    UInt64 mantissa;    // the (at most 19) leading significant digits
+    Int64 exp10;
+    UInt32 num_digits;  // number of digits in `mantissa`
+    bool truncated;     // set if non-zero digits after the first 19 were dropped
+} NumberDecimal;
+
+// The layout of a (binary) IEEE 754 float
+typedef struct NumberFormat {
+    UInt32 mantissa_bits;   // number of explicit mantissa bits
+    Int32 exponent_bias;
+    UInt64 infinite_exp;    // the (biased) exponent of Inf and NaN
+    Int64 min_exp10;        // a value whose leading digit is at 10^min_exp10 (or below) rounds to 0
+    Int64 max_exp10;        // a value whose leading digit is at 10^max_exp10 (or above) rounds to Inf
+} NumberFormat;
+
+static const NumberFormat numberFormatF64 = { 52, 1023, 0x7FF, -325, 309 };
+static const NumberFormat numberFormatF32 = { 23, 127, 0xFF, -47, 39 };
+
+// Powers of 10 that Float64 and Float32 represent exactly (for the Clinger fast path)
+static const Float64 numberExactPowersF64[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+    1e20, 1e21, 1e22
+};
+static const Float32 numberExactPowersF32[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+static inline bool number_is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Scan the float literal [str, str + len). Returns false if it isn't one
+static bool number_scan(const char* str, Ll len, NumberDecimal* decimal) {
+    const char* end = str + len;
+    UInt64 mantissa = 0;
+    UInt32 num_digits = 0;      // number of significant digits in `mantissa`
+    Int64 exp10 = 0;
+    bool truncated = false;
+    bool any_digits = false;
+
+    // Integer part. Leading zeros aren't significant
+    for(; str < end && (number_is_digit(*str) || *str == '_'); str++) {
+        if(*str == '_')
+            continue;
+        any_digits = true;
+        if(num_digits < 19) {
+            if(mantissa != 0 || *str != '0') {
+                mantissa = mantissa * 10 + cast(UInt64)(*str - '0');
+                num_digits++;
+            }
+        } else {
+            exp10++;
+            truncated |= *str != '0';
+        }
+    }
+
+    // Fraction
+    if(str < end && *str == '.') {
+        for(str++; str < end && (number_is_digit(*str) || *str == '_'); str++) {
+            if(*str == '_')
+                continue;
+            any_digits = true;
+            if(num_digits < 19) {
+                if(mantissa != 0 || *str != '0') {
+                    mantissa = mantissa * 10 + cast(UInt64)(*str - '0');
+                    num_digits++;
+                }
+                exp10--;
+            } else {
+                truncated |= *str != '0';
+            }
+        }
+    }
+    if(!any_digits)
+        return false;
+
+    // Exponent. It saturates well beyond the range of any float (where the value is either 0 or Inf anyway)
+    if(str < end && (*str == 'e' || *str == 'E')) {
+        str++;
+        bool negative = false;
+        if(str < end && (*str == '+' || *str == '-'))
+            negative = *str++ == '-';
+        Int64 exponent = 0;
+        bool any_exp_digits = false;
+        for(; str < end && (number_is_digit(*str) || *str == '_'); str++) {
+            if(*str == '_')
+                continue;
+            any_exp_digits = true;
+            if(exponent < 100000)
+                exponent = exponent * 10 + (*str - '0');
+        }
+        if(!any_exp_digits)
+            return false;
+        exp10 += negative ? -exponent : exponent;
+    }
+    if(str != end)
+        return false;
+
+    decimal->mantissa = mantissa;
+    decimal->exp10 = exp10;
+    decimal->num_digits = num_digits;
+    decimal->truncated = truncated;
+    return true;
+}
+
+static inline UInt32 number_clz64(UInt64 x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return cast(UInt32)__builtin_clzll(x);
+#else
+    UInt32 n = 0;
+    while(!(x & 0x8000000000000000ULL)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Returns the low 64 bits of `a * b`, and stores the high 64 bits in `hi`
+static inline UInt64 number_mul_64(UInt64 a, UInt64 b, UInt64* hi) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = cast(unsigned __int128)a * b;
+    *hi = cast(UInt64)(product >> 64);
+    return cast(UInt64)product;
+#else
+    UInt64 a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    UInt64 b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    UInt64 lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi;
+    UInt64 mid = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    *hi = a_hi * b_hi + (hi_lo >> 32) + (mid >> 32);
+    return (mid << 32) | (lo_lo & 0xFFFFFFFF);
+#endif // __SIZEOF_INT128__
+}
+
+// The Eisel-Lemire algorithm: computes the bits of the float nearest to `mantissa * 10^exp10` (`mantissa` is
+// non-zero). Returns false if it can't be decided this way
+static bool number_eisel_lemire(UInt64 mantissa, Int64 exp10, const NumberFormat* format, UInt64* bits) {
+    if(exp10 < NUMBER_POW10_MIN_EXP || exp10 > NUMBER_POW10_MAX_EXP)
+        return false;
+
+    // Normalize the mantissa, and estimate the binary exponent (`217706 / 2^16` approximates log2(10))
+    UInt32 clz = number_clz64(mantissa);
+    mantissa <<= clz;
+    UInt64 exp2 = cast(UInt64)(((217706 * exp10) >> 16) + 64 + format->exponent_bias) - clz;
+
+    // Multiply by the 128-bit approximation of 10^exp10. The low 64 bits of the table entry are only needed if the
+    // bits below the result's mantissa (and its rounding bit) are all ones, where they might carry into it
+    const UInt64* power = numberPowersOf10[exp10 - NUMBER_POW10_MIN_EXP];
+    UInt32 shift = 64 - format->mantissa_bits - 3;
+    UInt64 mask = (1ULL << shift) - 1;
+    UInt64 hi;
+    UInt64 lo = number_mul_64(mantissa, power[1], &hi);
+    if((hi & mask) == mask && lo + mantissa < mantissa) {
+        UInt64 wider_hi;
+        UInt64 wider_lo = number_mul_64(mantissa, power[0], &wider_hi);
+        UInt64 merged_hi = hi, merged_lo = lo + wider_hi;
+        if(merged_lo < lo)
+            merged_hi++;
+        if((merged_hi & mask) == mask && merged_lo + 1 == 0 && wider_lo + mantissa < mantissa)
+            return false;
+        hi = merged_hi;
+        lo = merged_lo;
+    }
+
+    // Keep the mantissa bits plus 2 (for rounding). A result exactly halfway between two floats can't be told
+    // apart from one just below it
+    UInt64 msb = hi >> 63;
+    UInt64 result = hi >> (msb + shift);
+    exp2 -= 1 ^ msb;
+    if(lo == 0 && (hi & mask) == 0 && (result & 3) == 1)
+        return false;
+
+    // Subnormals: round at the bit the smallest exponent leaves for the mantissa. `10^exp10` is then far from a
+    // power of 2 (exp10 < -27), so the value can't lie exactly halfway between two subnormals
+    if(cast(Int64)exp2 <= 0) {
+        UInt64 drop = 1 - exp2;
+        if(drop >= 64) {
+            *bits = 0;
+            return true;
+        }
+        result >>= drop;
+        result += result & 1;
+        result >>= 1;
+        // (rounding up may carry into the exponent, giving the smallest normal float)
+        *bits = result;
+        return true;
+    }
+
+    // Round to nearest (ties to even), which may carry into the exponent
+    result += result & 1;
+    result >>= 1;
+    if(result >> (format->mantissa_bits + 1)) {
+        result >>= 1;
+        exp2++;
+    }
+    // Overflows to Inf
+    if(exp2 >= format->infinite_exp) {
+        *bits = format->infinite_exp << format->mantissa_bits;
+        return true;
+    }
+
+    *bits = (exp2 << format->mantissa_bits) | (result & ((1ULL << format->mantissa_bits) - 1));
+    return true;
+}
+
+// Eisel-Lemire, accounting for the digits that were dropped from `decimal`: its value lies between `mantissa` and
+// `mantissa + 1` (scaled by 10^exp10), so the result is only known if both round to the same float
+static bool number_decimal_to_bits(const NumberDecimal* decimal, const NumberFormat* format, UInt64* bits) {
+    // The value lies in [10^lead, 10^(lead + 1))
+    Int64 lead = decimal->exp10 + decimal->num_digits - 1;
+    if(decimal->mantissa == 0 || lead <= format->min_exp10) {
+        *bits = 0;
+        return true;
+    }
+    if(lead >= format->max_exp10) {
+        *bits = format->infinite_exp << format->mantissa_bits;
+        return true;
+    }
+    if(!number_eisel_lemire(decimal->mantissa, decimal->exp10, format, bits))
+        return false;
+    if(!decimal->truncated)
+        return true;
+    UInt64 upper;
+    return number_eisel_lemire(decimal->mantissa + 1, decimal->exp10, format, &upper) && upper == *bits;
+}
+
+// Copy the float literal [str, str + len) without its `_`s into a NUL-terminated string, for `strtod()`. The result
+// is `buff` if it fits in `size` Bytes, and must be freed otherwise
+static char* number_strip(const char* str, Ll len, char* buff, Ll size) {
+    char* out = len < size ? buff : cast(char*)malloc(len + 1);
+    CORETEN_ENFORCE_NN(out, "Could not allocate memory. Memory full.");
+    Ll n = 0;
+    for(Ll i = 0; i < len; i++) {
+        if(str[i] != '_')
+            out[n++] = str[i];
+    }
+    out[n] = nullchar;
+    return out;
+}
+
+bool number_parse_f64(const char* str, Ll len, Float64* value) {
+    NumberDecimal decimal;
+    if(!number_scan(str, len, &decimal))
+        return false;
+
+    // Clinger's fast path: both the mantissa and the power of 10 are exact, so a single (correctly rounded)
+    // multiplication or division is
+    if(!decimal.truncated && decimal.mantissa <= (1ULL << 53) && decimal.exp10 >= -22 && decimal.exp10 <= 22) {
+        Float64 result = cast(Float64)decimal.mantissa;
+        if(decimal.exp10 < 0)
+            result /= numberExactPowersF64[-decimal.exp10];
+        else
+            result *= numberExactPowersF64[decimal.exp10];
+        *value = result;
+        return true;
+    }
+
+    UInt64 bits;
+    if(number_decimal_to_bits(&decimal, &numberFormatF64, &bits)) {
+        memcpy(value, &bits, sizeof(Float64));
+        return true;
+    }
+
+    char buff[128];
+    char* stripped = number_strip(str, len, buff, sizeof(buff));
+    *value = strtod(stripped, null);
+    if(stripped != buff)
+        free(stripped);
+    return true;
+}
+
+bool number_parse_f32(const char* str, Ll len, Float32* value) {
+    NumberDecimal decimal;
+    if(!number_scan(str, len, &decimal))
+        return false;
+
+    if(!decimal.truncated && decimal.mantissa <= (1ULL << 24) && decimal.exp10 >= -10 && decimal.exp10 <= 10) {
+        Float32 result = cast(Float32)decimal.mantissa;
+        if(decimal.exp10 < 0)
+            result /= numberExactPowersF32[-decimal.exp10];
+        else
+            result *= numberExactPowersF32[decimal.exp10];
+        *value = result;
+        return true;
+    }
+
+    UInt64 bits;
+    if(number_decimal_to_bits(&decimal, &numberFormatF32, &bits)) {
+        UInt32 bits32 = cast(UInt32)bits;
+        memcpy(value, &bits32, sizeof(Float32));
+        return true;
+    }
+
+    char buff[128];
+    char* stripped = number_strip(str, len, buff, sizeof(buff));
+    *value = strtof(stripped, null);
+    if(stripped != buff)
+        free(stripped);
+    return true;
+}
+
 // -------------------------------------------------------------------------
 // os.h
 // -------------------------------------------------------------------------
@@ -1406,7 +1902,7 @@ bool os_path_is_root(cstlBuffer* path) {
 #endif // UTF8_UINT16_MAX
 
 #include <adorad/core/utf8_data.h>
-// #include <adorad/core/utf8_properties.h>
+#include <adorad/core/utf8_properties.h>
 
 const Rune codepoint_decoded_length[256] = {
     // Basic Latin
@@ -1556,6 +2052,335 @@ static inline char* utf8_encode(Rune value) {
     return dst;
 }
 
+// -------------------------------------------------------------------------
+// UTF-8 validation
+// -------------------------------------------------------------------------
+// Validation follows the "lookup" algorithm of Keiser & Lemire ("Validating UTF-8 In Less Than One Instruction Per
+// Byte", https://github.com/lemire/fastvalidate-utf-8, also used by simdjson): every byte is classified by three
+// 16-entry table lookups (the high and low nibbles of the previous byte, and the high nibble of the current one).
+// Each table entry is a set of error bits, and an error is present only where all three lookups agree. Checking that
+// the 2nd/3rd continuation bytes of 3 and 4-byte sequences are where they belong is done separately. Blocks of pure
+// ASCII skip the lookups altogether.
+// Without SSSE3 (for `pshufb`), AVX2 or NEON, validation falls back to a scalar loop with an 8-byte ASCII fast path.
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define UTF8_SIMD_WIDTH     32
+    typedef __m256i Utf8Vec;
+    #define utf8_vec_load(p)            _mm256_loadu_si256(cast(const __m256i*)(p))
+    #define utf8_vec_table(t)           _mm256_broadcastsi128_si256(_mm_loadu_si128(cast(const __m128i*)(t)))
+    #define utf8_vec_set1(c)            _mm256_set1_epi8(cast(char)(c))
+    #define utf8_vec_zero()             _mm256_setzero_si256()
+    #define utf8_vec_lookup(t, idx)     _mm256_shuffle_epi8((t), (idx))
+    #define utf8_vec_shr4(v)            _mm256_and_si256(_mm256_srli_epi16((v), 4), _mm256_set1_epi8(0x0F))
+    #define utf8_vec_and(a, b)          _mm256_and_si256((a), (b))
+    #define utf8_vec_or(a, b)           _mm256_or_si256((a), (b))
+    #define utf8_vec_xor(a, b)          _mm256_xor_si256((a), (b))
+    #define utf8_vec_subs(a, b)         _mm256_subs_epu8((a), (b))
+    // The last `n` bytes of `prev` followed by the first `32 - n` bytes of `input`
+    #define utf8_vec_prev(input, prev, n)   \
+        _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (n))
+    #define utf8_vec_any(v)             (!_mm256_testz_si256((v), (v)))
+    #define utf8_vec_is_ascii(v)        (_mm256_movemask_epi8(v) == 0)
+#elif defined(__SSSE3__)
+    #include <tmmintrin.h>
+    #define UTF8_SIMD_WIDTH     16
+    typedef __m128i Utf8Vec;
+    #define utf8_vec_load(p)            _mm_loadu_si128(cast(const __m128i*)(p))
+    #define utf8_vec_table(t)           _mm_loadu_si128(cast(const __m128i*)(t))
+    #define utf8_vec_set1(c)            _mm_set1_epi8(cast(char)(c))
+    #define utf8_vec_zero()             _mm_setzero_si128()
+    #define utf8_vec_lookup(t, idx)     _mm_shuffle_epi8((t), (idx))
+    #define utf8_vec_shr4(v)            _mm_and_si128(_mm_srli_epi16((v), 4), _mm_set1_epi8(0x0F))
+    #define utf8_vec_and(a, b)          _mm_and_si128((a), (b))
+    #define utf8_vec_or(a, b)           _mm_or_si128((a), (b))
+    #define utf8_vec_xor(a, b)          _mm_xor_si128((a), (b))
+    #define utf8_vec_subs(a, b)         _mm_subs_epu8((a), (b))
+    #define utf8_vec_prev(input, prev, n)   _mm_alignr_epi8((input), (prev), 16 - (n))
+    #define utf8_vec_any(v)             (_mm_movemask_epi8(_mm_cmpeq_epi8((v), _mm_setzero_si128())) != 0xFFFF)
+    #define utf8_vec_is_ascii(v)        (_mm_movemask_epi8(v) == 0)
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+    #define UTF8_SIMD_WIDTH     16
+    typedef uint8x16_t Utf8Vec;
+    #define utf8_vec_load(p)            vld1q_u8(cast(const UInt8*)(p))
+    #define utf8_vec_table(t)           vld1q_u8(t)
+    #define utf8_vec_set1(c)            vdupq_n_u8(c)
+    #define utf8_vec_zero()             vdupq_n_u8(0)
+    #define utf8_vec_lookup(t, idx)     vqtbl1q_u8((t), (idx))
+    #define utf8_vec_shr4(v)            vshrq_n_u8((v), 4)
+    #define utf8_vec_and(a, b)          vandq_u8((a), (b))
+    #define utf8_vec_or(a, b)           vorrq_u8((a), (b))
+    #define utf8_vec_xor(a, b)          veorq_u8((a), (b))
+    #define utf8_vec_subs(a, b)         vqsubq_u8((a), (b))
+    #define utf8_vec_prev(input, prev, n)   vextq_u8((prev), (input), 16 - (n))
+    #define utf8_vec_any(v)             (vmaxvq_u8(v) != 0)
+    #define utf8_vec_is_ascii(v)        (vmaxvq_u8(v) < 0x80)
+#endif
+
+// Returns the length of the longest valid UTF-8 prefix of `data[0, len)`, starting the search at `i` (which must be
+// the beginning of a character)
+static UInt64 __utf8_validate_scalar(const Byte* data, UInt64 i, UInt64 len) {
+    while(i < len) {
+        // ASCII: 8 bytes at a time
+        if(i + 8 <= len) {
+            UInt64 word;
+            memcpy(&word, data + i, sizeof(word));
+            if(!(word & 0x8080808080808080ULL)) {
+                i += 8;
+                continue;
+            }
+        }
+
+        Byte byte = data[i];
+        if(byte < 0x80) {
+            ++i;
+            continue;
+        }
+
+        // See the grammar in utf8.h: the range of the 2nd byte depends on the 1st byte
+        UInt64 nbytes;
+        Byte lo = 0x80, hi = 0xBF;
+        if(byte >= 0xC2 && byte <= 0xDF) {
+            nbytes = 2;
+        } else if(byte >= 0xE0 && byte <= 0xEF) {
+            nbytes = 3;
+            if(byte == 0xE0) lo = 0xA0;
+            else if(byte == 0xED) hi = 0x9F;
+        } else if(byte >= 0xF0 && byte <= 0xF4) {
+            nbytes = 4;
+            if(byte == 0xF0) lo = 0x90;
+            else if(byte == 0xF4) hi = 0x8F;
+        } else {
+            return i;
+        }
+
+        if(i + nbytes > len || data[i + 1] < lo || data[i + 1] > hi)
+            return i;
+        for(UInt64 k = 2; k < nbytes; k++) {
+            if((data[i + k] & 0xC0) != 0x80)
+                return i;
+        }
+        i += nbytes;
+    }
+    return i;
+}
+
+#ifdef UTF8_SIMD_WIDTH
+// Error bits (set in the 3 lookup tables below)
+#define UTF8_TOO_SHORT      (1 << 0)    // 11______ 0_______ or 11______ 11______
+#define UTF8_TOO_LONG       (1 << 1)    // 0_______ 10______
+#define UTF8_OVERLONG_3     (1 << 2)    // 11100000 100_____
+#define UTF8_TOO_LARGE      (1 << 3)    // 11110100 1001____ (and larger)
+#define UTF8_SURROGATE      (1 << 4)    // 11101101 101_____
+#define UTF8_OVERLONG_2     (1 << 5)    // 1100000_ 10______
+#define UTF8_TOO_LARGE_1000 (1 << 6)    // 11110101 1000____ (and larger)
+#define UTF8_OVERLONG_4     (1 << 6)    // 11110000 1000____
+#define UTF8_TWO_CONTS      (1 << 7)    // 10______ 10______
+// These errors don't depend on the low nibble of the first byte
+#define UTF8_CARRY          (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+// Indexed by the high nibble of the previous byte
+static const Byte utf8_byte_1_high[16] = {
+    // 0_______ ________
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    // 10______ ________
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    // 1100____ ________
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    // 1101____ ________
+    UTF8_TOO_SHORT,
+    // 1110____ ________
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    // 1111____ ________
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+};
+
+// Indexed by the low nibble of the previous byte
+static const Byte utf8_byte_1_low[16] = {
+    // ____0000 ________
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+    // ____0001 ________
+    UTF8_CARRY | UTF8_OVERLONG_2,
+    // ____001_ ________
+    UTF8_CARRY,
+    UTF8_CARRY,
+    // ____0100 ________
+    UTF8_CARRY | UTF8_TOO_LARGE,
+    // ____0101 ________ and above
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    // ____1101 ________
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+};
+
+// Indexed by the high nibble of the current byte
+static const Byte utf8_byte_2_high[16] = {
+    // ________ 0_______
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    // ________ 1000____
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+    // ________ 1001____
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+    // ________ 101_____
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    // ________ 11______
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+};
+
+// A block ends with an incomplete character if any of its last 3 bytes is a lead byte needing more bytes than are
+// left in the block: a block whose bytes are greater than these (saturating subtraction) does
+static const Byte utf8_incomplete_max[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+// Returns the error bits of the block `input` (nonzero if it isn't valid UTF-8). `prev_input` is the previous block
+static inline Utf8Vec __utf8_check_block(Utf8Vec input, Utf8Vec prev_input) {
+    Utf8Vec prev1 = utf8_vec_prev(input, prev_input, 1);
+    Utf8Vec byte_1_high = utf8_vec_lookup(utf8_vec_table(utf8_byte_1_high), utf8_vec_shr4(prev1));
+    Utf8Vec byte_1_low = utf8_vec_lookup(utf8_vec_table(utf8_byte_1_low), utf8_vec_and(prev1, utf8_vec_set1(0x0F)));
+    Utf8Vec byte_2_high = utf8_vec_lookup(utf8_vec_table(utf8_byte_2_high), utf8_vec_shr4(input));
+    Utf8Vec special_cases = utf8_vec_and(utf8_vec_and(byte_1_high, byte_1_low), byte_2_high);
+
+    // Only 111_____ (2 bytes back) and 1111____ (3 bytes back) are >= 0x80 after the subtraction. Exactly these
+    // positions must be continuation bytes - and they are the ones flagged `UTF8_TWO_CONTS` above.
+    Utf8Vec prev2 = utf8_vec_prev(input, prev_input, 2);
+    Utf8Vec prev3 = utf8_vec_prev(input, prev_input, 3);
+    Utf8Vec must_be_cont = utf8_vec_or(utf8_vec_subs(prev2, utf8_vec_set1(0xE0 - 0x80)),
+                                       utf8_vec_subs(prev3, utf8_vec_set1(0xF0 - 0x80)));
+    return utf8_vec_xor(utf8_vec_and(must_be_cont, utf8_vec_set1(0x80)), special_cases);
+}
+#endif // UTF8_SIMD_WIDTH
+
+// Returns the length of the longest valid UTF-8 prefix of `str` (`len` bytes long).
+// `str` is valid UTF-8 if (and only if) this is `len`; otherwise, this is the offset of the first invalid sequence.
+UInt64 utf8_validate(const char* str, UInt64 len) {
+    const Byte* data = cast(const Byte*)str;
+    UInt64 i = 0;
+
+#ifdef UTF8_SIMD_WIDTH
+    Utf8Vec prev_input = utf8_vec_zero();
+    Utf8Vec prev_incomplete = utf8_vec_zero();
+    Utf8Vec incomplete_max = utf8_vec_load(utf8_incomplete_max + 32 - UTF8_SIMD_WIDTH);
+    for(; i + UTF8_SIMD_WIDTH <= len; i += UTF8_SIMD_WIDTH) {
+        Utf8Vec input = utf8_vec_load(data + i);
+        Utf8Vec error;
+        if(utf8_vec_is_ascii(input)) {
+            error = prev_incomplete;
+            prev_incomplete = utf8_vec_zero();
+        } else {
+            error = __utf8_check_block(input, prev_input);
+            prev_incomplete = utf8_vec_subs(input, incomplete_max);
+        }
+        if(utf8_vec_any(error))
+            break;
+        prev_input = input;
+    }
+
+    // Everything before `i` is valid, except (maybe) a character that is cut off at `i`. The scalar loop takes over
+    // from the start of that character to pinpoint the error (if any) and to validate the tail.
+    if(i > 0) {
+        UInt64 end = i;
+        i = i < 3 ? 0 : i - 3;
+        while(i < end && (data[i] & 0xC0) == 0x80)
+            ++i;
+    }
+#endif // UTF8_SIMD_WIDTH
+
+    return __utf8_validate_scalar(data, i, len);
+}
+
+// Decode the character at `str`. `str` must be valid UTF-8 (see `utf8_validate()`), so the lead byte alone tells
+// us the length of the sequence.
+Rune utf8_decode(const char* str, Ll* nbytes) {
+    const Byte* s = cast(const Byte*)str;
+    if(s[0] < 0x80) {
+        *nbytes = 1;
+        return s[0];
+    }
+    if(s[0] < 0xE0) {
+        *nbytes = 2;
+        return (cast(Rune)(s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+    }
+    if(s[0] < 0xF0) {
+        *nbytes = 3;
+        return (cast(Rune)(s[0] & 0x0F) << 12) | (cast(Rune)(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+    }
+    *nbytes = 4;
+    return (cast(Rune)(s[0] & 0x07) << 18) | (cast(Rune)(s[1] & 0x3F) << 12) | (cast(Rune)(s[2] & 0x3F) << 6) |
+           (s[3] & 0x3F);
+}
+
+Ll utf8_encode_to(char* dst, Rune uc) {
+    if(uc < 0x80) {
+        dst[0] = cast(char)uc;
+        return 1;
+    }
+    if(uc < 0x800) {
+        dst[0] = cast(char)(0xC0 | (uc >> 6));
+        dst[1] = cast(char)(0x80 | (uc & 0x3F));
+        return 2;
+    }
+    if(uc < 0x10000) {
+        dst[0] = cast(char)(0xE0 | (uc >> 12));
+        dst[1] = cast(char)(0x80 | ((uc >> 6) & 0x3F));
+        dst[2] = cast(char)(0x80 | (uc & 0x3F));
+        return 3;
+    }
+    dst[0] = cast(char)(0xF0 | (uc >> 18));
+    dst[1] = cast(char)(0x80 | ((uc >> 12) & 0x3F));
+    dst[2] = cast(char)(0x80 | ((uc >> 6) & 0x3F));
+    dst[3] = cast(char)(0x80 | (uc & 0x3F));
+    return 4;
+}
+
+// Properties of `uc`: `utf8_stage1table` maps the upper bits of `uc` to a 256-entry block of `utf8_stage2table`,
+// which holds the index of its entry in `utf8_properties`
+static inline const utf8_property_t* utf8_property(Rune uc) {
+    if(uc > CORETEN_RUNE_MAX)
+        return utf8_properties;
+    return utf8_properties + utf8_stage2table[utf8_stage1table[uc >> 8] + (uc & 0xFF)];
+}
+
+Int16 utf8_category(Rune uc) {
+    return utf8_property(uc)->category;
+}
+
+// XID_Start and XID_Continue are derived from the general category as in UAX #31 (letters and letter numbers
+// start an identifier; marks, digits and connector punctuation may continue it), plus the handful of codepoints
+// that Unicode keeps in these sets for backwards compatibility (Other_ID_Start/Other_ID_Continue)
+bool utf8_is_xid_start(Rune uc) {
+    switch(utf8_category(uc)) {
+        case UTF8_CATEGORY_LU: case UTF8_CATEGORY_LL: case UTF8_CATEGORY_LT: case UTF8_CATEGORY_LM:
+        case UTF8_CATEGORY_LO: case UTF8_CATEGORY_NL:
+            return true;
+        default:
+            return uc == 0x1885 || uc == 0x1886 || uc == 0x2118 || uc == 0x212E || uc == 0x309B || uc == 0x309C;
+    }
+}
+
+bool utf8_is_xid_continue(Rune uc) {
+    switch(utf8_category(uc)) {
+        case UTF8_CATEGORY_MN: case UTF8_CATEGORY_MC: case UTF8_CATEGORY_ND: case UTF8_CATEGORY_PC:
+            return true;
+        default:
+            return utf8_is_xid_start(uc) || uc == 0x00B7 || uc == 0x0387 || (uc >= 0x1369 && uc <= 0x1371) ||
+                   uc == 0x19DA;
+    }
+}
+
 /*
     WIP
 */
@@ -1753,9 +2578,24 @@ cstlVector* _vec_new(UInt64 objsize, UInt64 capacity) {
     return vec;
 } 
 
+cstlVector* _vec_new_in(cstlArena* arena, UInt64 objsize, UInt64 capacity) {
+    CORETEN_ENFORCE_NN(arena, "Expected not null");
+    if(capacity == 0)
+        capacity = VEC_ARENA_INIT_CAP;
+
+    cstlVector* vec = cast(cstlVector*)arena_alloc(arena, sizeof(cstlVector), sizeof(UInt64));
+    vec->internal.data = cast(void**)arena_alloc(arena, objsize * capacity, sizeof(UInt64));
+    memset(vec->internal.data, 0, objsize * capacity);
+    vec->internal.capacity = capacity;
+    vec->internal.size = 0;
+    vec->internal.objsize = objsize;
+    vec->internal.arena = arena;
+    return vec;
+}
+
 // Free a cstlVector from it's associated memory
 void vec_free(cstlVector* vec) {
-    if(vec) {
+    if(vec && !vec->internal.arena) {
         if(vec->internal.data)
             free(vec->internal.data);
         free(vec);
@@ -1885,7 +2725,12 @@ bool __vec_grow(cstlVector* vec, UInt64 capacity) {
     if (capacity > newcapacity || newcapacity >= (size_t) -1 / vec->internal.objsize)
         newcapacity = capacity;
 
-    newdata = realloc(vec->internal.data, newcapacity * vec->internal.objsize);
+    if(vec->internal.arena) {
+        newdata = arena_alloc(vec->internal.arena, newcapacity * vec->internal.objsize, sizeof(UInt64));
+        memcpy(newdata, vec->internal.data, vec->internal.size * vec->internal.objsize);
+    } else {
+        newdata = realloc(vec->internal.data, newcapacity * vec->internal.objsize);
+    }
     CORETEN_ENFORCE_NN(newdata, "Expected not null");
 
     vec->internal.data = newdata;
@@ -14,6 +14,8 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 #ifndef CORETEN_IO_H
 #define CORETEN_IO_H
 
+#include <adorad/core/types.h>
+
 typedef struct File {
     char* full_path;
     char* basename;
@@ -22,7 +24,18 @@ typedef struct File {
     char* contents;
 } File;
 
+// The contents of a file, mapped into memory (see `file_map()`)
+typedef struct FileMap {
+    char* contents;     // `len` bytes, followed by a `\0`
+    UInt64 len;         // length of the file
+    UInt64 mapped_len;  // length of the mapping (0 if `contents` had to be read into the heap instead)
+} FileMap;
+
 char* readFile(const char* fname);
+FileMap* file_map(const char* fname);
+// Like `file_map()`, but returns null instead of exiting if the file can't be opened or read
+FileMap* file_try_map(const char* fname);
+void file_unmap(FileMap* map);
 bool file_exists(const char* path);
 
 #endif // CORETEN_IO_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+
+#ifndef CORETEN_NUMBER_H
+#define CORETEN_NUMBER_H
+
+#include <adorad/core/types.h>
+
+/*
+    Parsing of floating-point literals
+
+    `number_parse_f64()` and `number_parse_f32()` read a literal straight from its source text (without a copy or a
+    NUL terminator) and return the nearest Float64/Float32, exactly as `strtod()`/`strtof()` would (ties round to
+    even). The literal syntax is Adorad's:
+        digits [`.` digits] [(`e`|`E`) [`+`|`-`] digits]
+    where the digits may be separated by `_`s, and either the integer part or the fraction may be empty (`.5`, `1.`).
+
+    Most literals take the Clinger fast path (an exact significand scaled by an exactly-representable power of 10)
+    or the Eisel-Lemire algorithm (a 64x128-bit multiplication by a table of powers of 10, see `number_data.h`).
+    The rare literals that Eisel-Lemire can't decide (values that are too close to halfway between two floats, and
+    significands of more than 19 digits that don't round the same both ways) are copied, without their `_`s, and
+    handed to `strtod()`/`strtof()`. These always see a `.` as the decimal point: the fallback assumes the C locale
+    (the default unless the program calls `setlocale()`), like the rest of the compiler.
+
+    Reference:
+        1. Daniel Lemire, "Number Parsing at a Gigabyte per Second" (https://arxiv.org/abs/2101.11408)
+        2. Nigel Tao, "The Eisel-Lemire ParseNumberF64 Algorithm" (https://nigeltao.github.io/blog/2020/eisel-lemire.html)
+*/
+
+// Parse the float literal [str, str + len) into `value`. Returns false, leaving `value` untouched, if it isn't one
+bool number_parse_f64(const char* str, Ll len, Float64* value);
+// Parse the float literal [str, str + len) into `value`. Returns false, leaving `value` untouched, if it isn't one
+bool number_parse_f32(const char* str, Ll len, Float32* value);
+
+#endif // CORETEN_NUMBER_H
@@ -52,6 +52,18 @@ typedef struct cstlUTF8Str {
     UInt64 nbytes; // no. of bytes used by the string
 } cstlUTF8Str;
 
+// Returns the length of the longest valid UTF-8 prefix of `str` (so `str` is valid iff this is `len`)
+UInt64 utf8_validate(const char* str, UInt64 len);
+// Decode the character at `str` (which must be valid UTF-8), storing its length (in bytes) in `nbytes`
+Rune utf8_decode(const char* str, Ll* nbytes);
+// Encode `uc` (a valid codepoint) into `dst`, which must have room for 4 bytes. Returns the number of bytes written
+Ll utf8_encode_to(char* dst, Rune uc);
+// Unicode general category of `uc`
+Int16 utf8_category(Rune uc);
+// Can `uc` begin an identifier? (XID_Start)
+bool utf8_is_xid_start(Rune uc);
+// Can `uc` continue an identifier? (XID_Continue)
+bool utf8_is_xid_continue(Rune uc);
 // Is UTF-8 codepoint valid?
 static inline bool utf8_is_codepoint_valid(Rune uc);
 static inline char* utf8_encode(Rune value);
@@ -183,4 +195,26 @@ typedef enum {
     UTF8_BOUNDCLASS_E_ZWG = 20, /* UTF8_BOUNDCLASS_EXTENDED_PICTOGRAPHIC + ZWJ */
 } cstlUTF8Boundclass;
 
+// Properties of a codepoint (see `utf8_properties.h`)
+typedef struct utf8_property_t {
+    Int16 category;
+    Int16 combining_class;
+    Int16 bidi_class;
+    Int16 decomp_type;
+    UInt16 decomp_seqindex;
+    UInt16 casefold_seqindex;
+    UInt16 uppercase_seqindex;
+    UInt16 lowercase_seqindex;
+    UInt16 titlecase_seqindex;
+    UInt16 comb_index;
+    unsigned bidi_mirrored:1;
+    unsigned comp_exclusion:1;
+    unsigned ignorable:1;
+    unsigned control_boundary:1;
+    unsigned charwidth:2;
+    unsigned pad:2;
+    // Boundclass (see `cstlUTF8Boundclass`)
+    unsigned boundclass:8;
+} utf8_property_t;
+
 #endif // CORETEN_UTF8_H
\ No newline at end of file
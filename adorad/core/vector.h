@@ -14,18 +14,25 @@ Copyright (c) 2021 Jason Dsouza <@jasmcaus>
 #ifndef CORETEN_VECTOR_H
 #define CORETEN_VECTOR_H
 
+#include <adorad/core/types.h>
+#include <adorad/core/arena.h>
+
 // We require this to be a large number, much more than what you might eventually use for more projects.
 // This is because CSTL is of great use and importance in the Adorad Programming Language (which requires
 // these many tokens during lexing/tokenization). Having a large number reduces the number of `realloc`s.
 #define VEC_INIT_ALLOC_CAP      4096
 #define VECTOR_AT_MACRO(v, i)   ((void *)((char *) (v)->internal.data + (i) * (v)->internal.objsize))
+// Initial capacity of a vector allocated from an Arena if none is given (these are meant to be small)
+#define VEC_ARENA_INIT_CAP      4
 #define vec_new(obj, nelem)     _vec_new(sizeof(obj), (nelem))
+#define vec_new_in(arena, obj, nelem)   _vec_new_in((arena), sizeof(obj), (nelem))
 
 typedef struct {
     void** data;      // pointer to the underlying memory
     UInt64 size;      // number of elements currently in `vec`
     UInt64 capacity;  // allocated memory capacity (no. of elements)
     UInt64 objsize;   // size of each element in bytes
+    cstlArena* arena; // set if the memory comes from an Arena (see `vec_new_in()`)
 } cstlVectorInternal;
 
 // The actual `cstlVector` struct
@@ -36,6 +43,9 @@ struct cstlVector {
 };
 
 cstlVector* _vec_new(UInt64 objsize, UInt64 capacity);
+// Create a vector whose memory comes from `arena`: growing it leaves the old elements behind in the Arena, and
+// `vec_free()` is a no-op (the memory goes away with the Arena)
+cstlVector* _vec_new_in(cstlArena* arena, UInt64 objsize, UInt64 capacity);
 bool __vec_grow(cstlVector* vec, UInt64 capacity);
 void vec_free(cstlVector* vec);
 void* vec_at(cstlVector* vec, UInt64 elem);
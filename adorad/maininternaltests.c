@@ -2,8 +2,8 @@
 
 int main(int argc, const char* const argv[]) {
     // The CWD for this executable is in ".../build/bin"
-	char* buffer = readFile("../../test/LexerDemo.ad");
-	Lexer* lexer = lexer_init(buffer, "test/LexerDemo.ad"); 
+	FileMap* file = file_map("../../test/LexerDemo.ad");
+	Lexer* lexer = lexer_init_mapped(file, "test/LexerDemo.ad"); 
 
     clock_t st, end;
     printf("Lexing beginning...\n");
@@ -15,15 +15,18 @@ int main(int argc, const char* const argv[]) {
     double total = duration(st, end);
 
     printf("\033[1;32m\nTokens Vector: \033[0m\n");
-    for(UInt64 i=0; i < vec_size(lexer->toklist); i++) {
-        Token* tok = vec_at(lexer->toklist, i);
-        printf("TOKEN(%s, \"%s\")\n", token_to_buff(tok->kind)->data, tok->value->data);
+    for(TokenIndex i=0; i < lexer->toklist->size; i++) {
+        Token tok = tokenlist_at(lexer->toklist, i);
+        printf("TOKEN(%s, \"%.*s\")\n", token_to_buff(tok.kind)->data, (int)tok.len, lexer->buffer->data + tok.offset);
     } 
     printf("\nTotal time = %lfs\n", total);
 
-    printf("Number of tokens = %d\n", vec_size(lexer->toklist));
-    printf("Total allocated memory (in bytes) = %d\n", lexer->toklist->internal.objsize * vec_size(lexer->toklist));
+    printf("Number of tokens = %u\n", lexer->toklist->size);
+    // See bench/ (`ADORAD_BUILD_BENCHMARKS`) for the throughput, allocations and peak RSS of the Lexer
+    printf("Token storage (in bytes) = %zu\n",
+           lexer->toklist->cap * (sizeof(UInt8) + 2 * sizeof(UInt32) + sizeof(Atom)));
     
     lexer_free(lexer);
+    file_unmap(file);
     return 0; 
 }
\ No newline at end of file
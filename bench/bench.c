@@ -0,0 +1,124 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+// `clock_gettime()` is POSIX (not ISO C), and must be requested before any system header is included
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(_DEFAULT_SOURCE)
+    #define _DEFAULT_SOURCE
+#endif
+
+#include <stdlib.h>
+#include <time.h>
+
+#include <adorad/core/os_defs.h>
+#include <adorad/core/misc.h>
+#include <bench/bench.h>
+
+#if defined(CORETEN_OS_WINDOWS)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif // CORETEN_OS_WINDOWS
+
+double bench_now() {
+#if defined(CORETEN_OS_WINDOWS)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return cast(double)counter.QuadPart / cast(double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return cast(double)ts.tv_sec + cast(double)ts.tv_nsec * 1e-9;
+#endif // CORETEN_OS_WINDOWS
+}
+
+UInt64 bench_peak_rss() {
+#if defined(CORETEN_OS_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return cast(UInt64)counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    #if defined(CORETEN_OS_OSX)
+        return cast(UInt64)usage.ru_maxrss;
+    #else
+        return cast(UInt64)usage.ru_maxrss * 1024;
+    #endif // CORETEN_OS_OSX
+#endif // CORETEN_OS_WINDOWS
+}
+
+const char* bench_compiler() {
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+bool bench_parse_size(const char* str, UInt64* size) {
+    char* end;
+    UInt64 value = strtoull(str, &end, 10);
+    switch(*end) {
+        case 'k': case 'K': value *= 1024; end++; break;
+        case 'm': case 'M': value *= 1024 * 1024; end++; break;
+        case 'g': case 'G': value *= 1024 * 1024 * 1024; end++; break;
+        default: break;
+    }
+    if(end == str || *end != nullchar || value == 0) {
+        fprintf(stderr, "Invalid size `%s`\n", str);
+        return false;
+    }
+    *size = value;
+    return true;
+}
+
+bool bench_parse_count(const char* str, UInt32* count) {
+    char* end;
+    unsigned long value = strtoul(str, &end, 10);
+    if(end == str || *end != nullchar) {
+        fprintf(stderr, "Invalid number `%s`\n", str);
+        return false;
+    }
+    *count = cast(UInt32)value;
+    return true;
+}
+
+void bench_json_string(FILE* out, const char* str) {
+    fputc('"', out);
+    for(; *str; str++) {
+        if(*str == '"' || *str == '\\')
+            fprintf(out, "\\%c", *str);
+        else if(cast(UInt8)*str < 0x20)
+            fprintf(out, "\\u%04x", *str);
+        else
+            fputc(*str, out);
+    }
+    fputc('"', out);
+}
+
+static int bench_compare_doubles(const void* a, const void* b) {
+    double x = *cast(const double*)a, y = *cast(const double*)b;
+    return (x > y) - (x < y);
+}
+
+double bench_median(double* seconds, UInt32 runs) {
+    qsort(seconds, runs, sizeof(double), bench_compare_doubles);
+    return runs % 2 ? seconds[runs / 2] : (seconds[runs / 2 - 1] + seconds[runs / 2]) / 2;
+}
@@ -0,0 +1,37 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+#ifndef ADORAD_BENCH_BENCH_H
+#define ADORAD_BENCH_BENCH_H
+
+#include <stdio.h>
+
+#include <adorad/core/types.h>
+
+// Helpers shared by the benchmarks
+
+// Wall-clock time (in seconds)
+double bench_now();
+// Peak resident set size of the process (in Bytes)
+UInt64 bench_peak_rss();
+// The compiler (and its version) the benchmark was built with
+const char* bench_compiler();
+// Parse a size such as `64K`, `16M` or `1G`. Returns false (after reporting it) if `str` isn't one
+bool bench_parse_size(const char* str, UInt64* size);
+// Parse a count. Returns false (after reporting it) if `str` isn't one
+bool bench_parse_count(const char* str, UInt32* count);
+// Write `str` as a JSON string
+void bench_json_string(FILE* out, const char* str);
+// Sort the timings of `runs` runs, and return their median
+double bench_median(double* seconds, UInt32 runs);
+
+#endif // ADORAD_BENCH_BENCH_H
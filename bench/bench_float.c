@@ -0,0 +1,324 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+// Float literal benchmark
+// Parses the float literals of a synthetic corpus (see corpus.h), of a source file, or randomly generated ones with
+// `number_parse_f64()`/`number_parse_f32()` and with `strtod()`/`strtof()`, checks that they agree on every literal,
+// and reports the time each of them takes. Run with `--help` for the options.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <adorad/adorad.h>
+#include <bench/bench.h>
+#include <bench/corpus.h>
+
+#ifndef ADORAD_VERSION_STRING
+    #define ADORAD_VERSION_STRING   "unknown"
+#endif
+
+static void usage(int status) {
+    fprintf(status ? stderr : stdout,
+        "Usage: adorad_bench_float [options]\n"
+        "  --size <n>[K|M|G]   size of the generated corpus (default: 16M)\n"
+        "  --mix <mix>         statement mix of the generated corpus (default: numbers, see adorad_bench_lexer)\n"
+        "  --seed <n>          seed of the generated corpus or of the random literals (default: 1)\n"
+        "  --file <path>       parse the float literals of <path> instead of a generated corpus\n"
+        "  --random <n>        parse <n> random literals (17 significant digits, exponents across the whole range of\n"
+        "                      Float64, some with `_` separators) instead of a generated corpus\n"
+        "  --runs <n>          number of timed runs (default: 10)\n"
+        "  --warmup <n>        number of untimed runs before them (default: 2)\n"
+        "  --json <path>       write the results as JSON to <path> (`-` for stdout)\n");
+    exit(status);
+}
+
+// The float literals to parse: `spans` point into the source text, and `plain` holds NUL-terminated copies without
+// `_`s (which is what `strtod()` needs - making them isn't timed)
+typedef struct BenchLiterals {
+    const char** spans;
+    UInt32* lens;
+    char** plain;
+    UInt32 count;
+    UInt32 cap;
+    UInt64 bytes;
+} BenchLiterals;
+
+static void bench_add_literal(BenchLiterals* literals, const char* span, UInt32 len) {
+    if(literals->count == literals->cap) {
+        literals->cap = literals->cap ? literals->cap * 2 : 1024;
+        literals->spans = cast(const char**)realloc(literals->spans, literals->cap * sizeof(const char*));
+        literals->lens = cast(UInt32*)realloc(literals->lens, literals->cap * sizeof(UInt32));
+        literals->plain = cast(char**)realloc(literals->plain, literals->cap * sizeof(char*));
+        CORETEN_ENFORCE(literals->spans && literals->lens && literals->plain, "Could not allocate memory. Memory full.");
+    }
+    char* plain = cast(char*)malloc(len + 1);
+    CORETEN_ENFORCE_NN(plain, "Could not allocate memory. Memory full.");
+    UInt32 n = 0;
+    for(UInt32 i = 0; i < len; i++) {
+        if(span[i] != '_')
+            plain[n++] = span[i];
+    }
+    plain[n] = nullchar;
+
+    literals->spans[literals->count] = span;
+    literals->lens[literals->count] = len;
+    literals->plain[literals->count] = plain;
+    literals->count++;
+    literals->bytes += len;
+}
+
+// Collect the FLOAT literals of `source`
+static void bench_collect_literals(FileMap* source, BenchLiterals* literals) {
+    Lexer* lexer = lexer_init_mapped(source, "<bench>");
+    lexer_lex(lexer);
+    for(TokenIndex i = 0; i < lexer->toklist->size; i++) {
+        Token tok = tokenlist_at(lexer->toklist, i);
+        if(tok.kind == FLOAT_LIT)
+            bench_add_literal(literals, source->contents + tok.offset, tok.len);
+    }
+    lexer_free(lexer);
+}
+
+// splitmix64
+static UInt64 bench_random(UInt64* state) {
+    UInt64 z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Generate `count` random literals such as `1.2345678901234567e-123` or `123_456.78901234567e+45`. The result is
+// the source text the literals point into
+static char* bench_random_literals(UInt32 count, UInt64 seed, BenchLiterals* literals) {
+    // At most 17 digits, 3 separators, a `.`, and `e-308`
+    const UInt32 max_len = 32;
+    char* text = cast(char*)malloc(cast(UInt64)count * max_len + 1);
+    CORETEN_ENFORCE_NN(text, "Could not allocate memory. Memory full.");
+    UInt64 state = seed;
+    char* out = text;
+    for(UInt32 i = 0; i < count; i++) {
+        char* begin = out;
+        bool separators = bench_random(&state) % 4 == 0;
+        UInt32 point = 1 + cast(UInt32)(bench_random(&state) % 16);
+        *out++ = cast(char)('1' + bench_random(&state) % 9);
+        for(UInt32 digit = 1; digit < 17; digit++) {
+            if(digit == point)
+                *out++ = '.';
+            else if(separators && digit < point && (point - digit) % 3 == 0)
+                *out++ = '_';
+            *out++ = cast(char)('0' + bench_random(&state) % 10);
+        }
+        int exponent = cast(int)(bench_random(&state) % 600) - 300;
+        out += sprintf(out, "e%c%d", exponent < 0 ? '-' : '+', exponent < 0 ? -exponent : exponent);
+        bench_add_literal(literals, begin, cast(UInt32)(out - begin));
+    }
+    *out = nullchar;
+    return text;
+}
+
+typedef enum BenchParser {
+    BENCH_NUMBER_F64 = 0,
+    BENCH_STRTOD,
+    BENCH_NUMBER_F32,
+    BENCH_STRTOF,
+    BENCH_NUM_PARSERS
+} BenchParser;
+
+static const char* benchParserNames[BENCH_NUM_PARSERS] = { "number_parse_f64", "strtod", "number_parse_f32", "strtof" };
+
+// Keeps the results of `bench_parse()` alive
+volatile Float64 benchSink;
+
+// Parse every literal with `parser`. Returns the time it took (in seconds)
+static double bench_parse(BenchParser parser, BenchLiterals* literals) {
+    // The sum keeps the results alive
+    Float64 sum = 0;
+    double start = bench_now();
+    switch(parser) {
+        case BENCH_NUMBER_F64:
+            for(UInt32 i = 0; i < literals->count; i++) {
+                Float64 value = 0;
+                number_parse_f64(literals->spans[i], literals->lens[i], &value);
+                sum += value;
+            }
+            break;
+        case BENCH_STRTOD:
+            for(UInt32 i = 0; i < literals->count; i++)
+                sum += strtod(literals->plain[i], null);
+            break;
+        case BENCH_NUMBER_F32:
+            for(UInt32 i = 0; i < literals->count; i++) {
+                Float32 value = 0;
+                number_parse_f32(literals->spans[i], literals->lens[i], &value);
+                sum += value;
+            }
+            break;
+        case BENCH_STRTOF:
+            for(UInt32 i = 0; i < literals->count; i++)
+                sum += strtof(literals->plain[i], null);
+            break;
+        default: break;
+    }
+    double seconds = bench_now() - start;
+    benchSink = sum;
+    return seconds;
+}
+
+// Check that every literal parses to the very same bits as with `strtod()` and `strtof()`. Returns the number of
+// literals that don't
+static UInt32 bench_verify(BenchLiterals* literals) {
+    UInt32 mismatches = 0;
+    for(UInt32 i = 0; i < literals->count; i++) {
+        Float64 value64 = 0;
+        Float32 value32 = 0;
+        bool ok = number_parse_f64(literals->spans[i], literals->lens[i], &value64) &&
+                  number_parse_f32(literals->spans[i], literals->lens[i], &value32);
+        Float64 expected64 = strtod(literals->plain[i], null);
+        Float32 expected32 = strtof(literals->plain[i], null);
+        if(!ok || memcmp(&value64, &expected64, sizeof(Float64)) != 0 ||
+           memcmp(&value32, &expected32, sizeof(Float32)) != 0) {
+            if(mismatches++ < 10)
+                fprintf(stderr, "Mismatch: `%.*s`\n", cast(int)literals->lens[i], literals->spans[i]);
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    UInt64 size = 16 * 1024 * 1024;
+    const char* mix_spec = "numbers";
+    UInt64 seed = 1;
+    const char* file = null;
+    const char* json = null;
+    UInt32 random = 0;
+    UInt32 runs = 10;
+    UInt32 warmup = 2;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if(strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+            usage(0);
+        if(i + 1 >= argc)
+            usage(1);
+
+        const char* value = argv[++i];
+        bool ok = true;
+        if(strcmp(arg, "--size") == 0)          ok = bench_parse_size(value, &size);
+        else if(strcmp(arg, "--mix") == 0)      mix_spec = value;
+        else if(strcmp(arg, "--seed") == 0)     seed = strtoull(value, null, 10);
+        else if(strcmp(arg, "--file") == 0)     file = value;
+        else if(strcmp(arg, "--random") == 0)   ok = bench_parse_count(value, &random);
+        else if(strcmp(arg, "--runs") == 0)     ok = bench_parse_count(value, &runs);
+        else if(strcmp(arg, "--warmup") == 0)   ok = bench_parse_count(value, &warmup);
+        else if(strcmp(arg, "--json") == 0)     json = value;
+        else {
+            fprintf(stderr, "Unknown option `%s`\n", arg);
+            usage(1);
+        }
+        if(!ok)
+            usage(1);
+    }
+    if(runs == 0)
+        usage(1);
+
+    // The literals to parse
+    BenchLiterals literals = {0};
+    FileMap* source = null;
+    char* text = null;
+    if(random) {
+        text = bench_random_literals(random, seed, &literals);
+    } else if(file) {
+        source = file_map(file);
+        bench_collect_literals(source, &literals);
+    } else {
+        CorpusMix mix;
+        if(!corpus_parse_mix(mix_spec, &mix)) {
+            fprintf(stderr, "Invalid mix `%s`\n", mix_spec);
+            usage(1);
+        }
+        CORETEN_ENFORCE(size < UInt32_MAX, "The Lexer is limited to sources of less than 4 GB");
+        source = cast(FileMap*)calloc(1, sizeof(FileMap));
+        CORETEN_ENFORCE_NN(source, "Could not allocate memory. Memory full.");
+        source->contents = corpus_generate(size, &mix, seed, &source->len);
+        bench_collect_literals(source, &literals);
+    }
+    if(literals.count == 0) {
+        fprintf(stderr, "No float literals to parse\n");
+        return 1;
+    }
+
+    UInt32 mismatches = bench_verify(&literals);
+
+    double medians[BENCH_NUM_PARSERS];
+    double* seconds = cast(double*)calloc(runs, sizeof(double));
+    CORETEN_ENFORCE_NN(seconds, "Could not allocate memory. Memory full.");
+    printf("Parsed %u float literals (%llu bytes) %u times\n", literals.count, cast(unsigned long long)literals.bytes,
+           runs);
+    for(UInt32 parser = 0; parser < BENCH_NUM_PARSERS; parser++) {
+        for(UInt32 i = 0; i < warmup; i++)
+            bench_parse(cast(BenchParser)parser, &literals);
+        for(UInt32 i = 0; i < runs; i++)
+            seconds[i] = bench_parse(cast(BenchParser)parser, &literals);
+        medians[parser] = bench_median(seconds, runs);
+        printf("  %-18s %8.2f ns/literal  %8.1f MB/s\n", benchParserNames[parser],
+               medians[parser] * 1e9 / literals.count, cast(double)literals.bytes / 1e6 / medians[parser]);
+    }
+    printf("  speedup over strtod(): %.2fx, over strtof(): %.2fx\n", medians[BENCH_STRTOD] / medians[BENCH_NUMBER_F64],
+           medians[BENCH_STRTOF] / medians[BENCH_NUMBER_F32]);
+    if(mismatches)
+        printf("  %u literal(s) parsed differently from strtod()/strtof()\n", mismatches);
+
+    if(json) {
+        FILE* out = strcmp(json, "-") == 0 ? stdout : fopen(json, "w");
+        CORETEN_ENFORCE_NN(out, "Could not open the JSON file");
+        fprintf(out, "{\n");
+        fprintf(out, "  \"benchmark\": \"float\",\n");
+        fprintf(out, "  \"version\": \"%s\",\n", ADORAD_VERSION_STRING);
+        fprintf(out, "  \"compiler\": ");
+        bench_json_string(out, bench_compiler());
+        if(random) {
+            fprintf(out, ",\n  \"corpus\": {\"random\": %u, \"seed\": %llu", random, cast(unsigned long long)seed);
+        } else if(file) {
+            fprintf(out, ",\n  \"corpus\": {\"file\": ");
+            bench_json_string(out, file);
+        } else {
+            fprintf(out, ",\n  \"corpus\": {\"mix\": ");
+            bench_json_string(out, mix_spec);
+            fprintf(out, ", \"seed\": %llu", cast(unsigned long long)seed);
+        }
+        fprintf(out, ", \"literals\": %u, \"bytes\": %llu},\n", literals.count, cast(unsigned long long)literals.bytes);
+        fprintf(out, "  \"runs\": %u,\n", runs);
+        fprintf(out, "  \"warmup\": %u,\n", warmup);
+        fprintf(out, "  \"mismatches\": %u,\n", mismatches);
+        fprintf(out, "  \"parsers\": {");
+        for(UInt32 parser = 0; parser < BENCH_NUM_PARSERS; parser++) {
+            fprintf(out, "%s\n    \"%s\": {\"median_seconds\": %.9f, \"ns_per_literal\": %.3f, \"mb_per_s\": %.3f}",
+                    parser ? "," : "", benchParserNames[parser], medians[parser],
+                    medians[parser] * 1e9 / literals.count, cast(double)literals.bytes / 1e6 / medians[parser]);
+        }
+        fprintf(out, "\n  }\n}\n");
+        if(out != stdout)
+            fclose(out);
+    }
+
+    for(UInt32 i = 0; i < literals.count; i++)
+        free(literals.plain[i]);
+    free(literals.plain);
+    free(literals.lens);
+    free(cast(void*)literals.spans);
+    free(seconds);
+    free(text);
+    if(source)
+        file_unmap(source);
+    return mismatches ? 1 : 0;
+}
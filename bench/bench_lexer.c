@@ -0,0 +1,249 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+// Lexer benchmark
+// Lexes a synthetic corpus (see corpus.h) or a source file over repeated runs and reports the throughput, the number
+// of allocations and the peak RSS. Run with `--help` for the options; `--json` writes the results in a form meant to
+// be tracked across releases.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <adorad/adorad.h>
+#include <bench/bench.h>
+#include <bench/corpus.h>
+
+#ifndef ADORAD_VERSION_STRING
+    #define ADORAD_VERSION_STRING   "unknown"
+#endif
+
+// Allocations
+// Where the linker supports it, the allocator is wrapped (`--wrap=malloc` etc., see CMakeLists.txt) so that every
+// allocation made while lexing is counted - including the ones made by the worker threads of `lexer_lex_parallel()`.
+#ifdef ADORAD_BENCH_COUNT_ALLOCATIONS
+static UInt64 benchAllocations = 0;
+static UInt64 benchAllocatedBytes = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+static inline void bench_count_allocation(UInt64 size) {
+    __atomic_fetch_add(&benchAllocations, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&benchAllocatedBytes, size, __ATOMIC_RELAXED);
+}
+
+void* __wrap_malloc(size_t size) {
+    bench_count_allocation(size);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    bench_count_allocation(cast(UInt64)count * size);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    bench_count_allocation(size);
+    return __real_realloc(ptr, size);
+}
+#endif // ADORAD_BENCH_COUNT_ALLOCATIONS
+
+static void usage(int status) {
+    fprintf(status ? stderr : stdout,
+        "Usage: adorad_bench_lexer [options]\n"
+        "  --size <n>[K|M|G]   size of the generated corpus (default: 16M)\n"
+        "  --mix <mix>         statement mix of the generated corpus: default, idents, numbers, strings, comments,\n"
+        "                      control, unicode, or weights such as `idents=3,strings=1` (default: default)\n"
+        "  --seed <n>          seed of the generated corpus (default: 1)\n"
+        "  --file <path>       lex <path> instead of a generated corpus\n"
+        "  --emit <path>       write the generated corpus to <path> and exit\n"
+        "  --runs <n>          number of timed runs (default: 10)\n"
+        "  --warmup <n>        number of untimed runs before them (default: 2)\n"
+        "  --threads <n>       lex on <n> threads with `lexer_lex_parallel()` (default: 1, i.e `lexer_lex()`)\n"
+        "  --json <path>       write the results as JSON to <path> (`-` for stdout)\n");
+    exit(status);
+}
+
+// Result of a single run
+typedef struct BenchRun {
+    double seconds;
+    UInt32 tokens;
+    UInt64 allocations;
+    UInt64 allocated_bytes;
+} BenchRun;
+
+static BenchRun bench_lex(FileMap* source, UInt32 threads) {
+    BenchRun run = {0};
+#ifdef ADORAD_BENCH_COUNT_ALLOCATIONS
+    UInt64 allocations = __atomic_load_n(&benchAllocations, __ATOMIC_RELAXED);
+    UInt64 allocated_bytes = __atomic_load_n(&benchAllocatedBytes, __ATOMIC_RELAXED);
+#endif // ADORAD_BENCH_COUNT_ALLOCATIONS
+
+    double start = bench_now();
+    Lexer* lexer = lexer_init_mapped(source, "<bench>");
+    if(threads > 1)
+        lexer_lex_parallel(lexer, threads);
+    else
+        lexer_lex(lexer);
+    run.seconds = bench_now() - start;
+    run.tokens = lexer->toklist->size;
+
+#ifdef ADORAD_BENCH_COUNT_ALLOCATIONS
+    run.allocations = __atomic_load_n(&benchAllocations, __ATOMIC_RELAXED) - allocations;
+    run.allocated_bytes = __atomic_load_n(&benchAllocatedBytes, __ATOMIC_RELAXED) - allocated_bytes;
+#endif // ADORAD_BENCH_COUNT_ALLOCATIONS
+
+    lexer_free(lexer);
+    return run;
+}
+
+int main(int argc, char** argv) {
+    UInt64 size = 16 * 1024 * 1024;
+    const char* mix_spec = "default";
+    UInt64 seed = 1;
+    const char* file = null;
+    const char* emit = null;
+    const char* json = null;
+    UInt32 runs = 10;
+    UInt32 warmup = 2;
+    UInt32 threads = 1;
+
+    for(int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if(strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+            usage(0);
+        if(i + 1 >= argc)
+            usage(1);
+
+        const char* value = argv[++i];
+        bool ok = true;
+        if(strcmp(arg, "--size") == 0)          ok = bench_parse_size(value, &size);
+        else if(strcmp(arg, "--mix") == 0)      mix_spec = value;
+        else if(strcmp(arg, "--seed") == 0)     seed = strtoull(value, null, 10);
+        else if(strcmp(arg, "--file") == 0)     file = value;
+        else if(strcmp(arg, "--emit") == 0)     emit = value;
+        else if(strcmp(arg, "--runs") == 0)     ok = bench_parse_count(value, &runs);
+        else if(strcmp(arg, "--warmup") == 0)   ok = bench_parse_count(value, &warmup);
+        else if(strcmp(arg, "--threads") == 0)  ok = bench_parse_count(value, &threads);
+        else if(strcmp(arg, "--json") == 0)     json = value;
+        else {
+            fprintf(stderr, "Unknown option `%s`\n", arg);
+            usage(1);
+        }
+        if(!ok)
+            usage(1);
+    }
+    if(runs == 0)
+        usage(1);
+
+    // The source to lex
+    FileMap* source;
+    if(file) {
+        source = file_map(file);
+    } else {
+        CorpusMix mix;
+        if(!corpus_parse_mix(mix_spec, &mix)) {
+            fprintf(stderr, "Invalid mix `%s`\n", mix_spec);
+            usage(1);
+        }
+        CORETEN_ENFORCE(size < UInt32_MAX, "The Lexer is limited to sources of less than 4 GB");
+        source = cast(FileMap*)calloc(1, sizeof(FileMap));
+        CORETEN_ENFORCE_NN(source, "Could not allocate memory. Memory full.");
+        source->contents = corpus_generate(size, &mix, seed, &source->len);
+
+        if(emit) {
+            FILE* out = fopen(emit, "wb");
+            CORETEN_ENFORCE_NN(out, "Could not open the file to write the corpus to");
+            CORETEN_ENFORCE(fwrite(source->contents, 1, source->len, out) == source->len, "Could not write the corpus");
+            fclose(out);
+            file_unmap(source);
+            return 0;
+        }
+    }
+
+    for(UInt32 i = 0; i < warmup; i++)
+        bench_lex(source, threads);
+
+    BenchRun* results = cast(BenchRun*)calloc(runs, sizeof(BenchRun));
+    double* seconds = cast(double*)calloc(runs, sizeof(double));
+    CORETEN_ENFORCE(results && seconds, "Could not allocate memory. Memory full.");
+    double total = 0;
+    for(UInt32 i = 0; i < runs; i++) {
+        results[i] = bench_lex(source, threads);
+        seconds[i] = results[i].seconds;
+        total += seconds[i];
+    }
+    double median = bench_median(seconds, runs);
+    double mean = total / runs;
+    // Throughput is reported for the median run (in MB/s, i.e 10^6 Bytes per second)
+    double mb_per_s = cast(double)source->len / 1e6 / median;
+    double tokens_per_s = cast(double)results[0].tokens / median;
+    UInt64 peak_rss = bench_peak_rss();
+
+    printf("Lexed %llu bytes (%u tokens) %u times on %u thread(s)\n", cast(unsigned long long)source->len,
+           results[0].tokens, runs, threads);
+    printf("  time (min/median/mean/max): %.3f / %.3f / %.3f / %.3f ms\n", seconds[0] * 1e3, median * 1e3,
+           mean * 1e3, seconds[runs - 1] * 1e3);
+    printf("  throughput: %.1f MB/s, %.1f Mtokens/s\n", mb_per_s, tokens_per_s / 1e6);
+#ifdef ADORAD_BENCH_COUNT_ALLOCATIONS
+    printf("  allocations per run: %llu (%llu bytes)\n", cast(unsigned long long)results[0].allocations,
+           cast(unsigned long long)results[0].allocated_bytes);
+#endif // ADORAD_BENCH_COUNT_ALLOCATIONS
+    printf("  peak RSS: %.1f MB\n", cast(double)peak_rss / 1e6);
+
+    if(json) {
+        FILE* out = strcmp(json, "-") == 0 ? stdout : fopen(json, "w");
+        CORETEN_ENFORCE_NN(out, "Could not open the JSON file");
+        fprintf(out, "{\n");
+        fprintf(out, "  \"benchmark\": \"lexer\",\n");
+        fprintf(out, "  \"version\": \"%s\",\n", ADORAD_VERSION_STRING);
+        fprintf(out, "  \"compiler\": ");
+        bench_json_string(out, bench_compiler());
+        if(file) {
+            fprintf(out, ",\n  \"corpus\": {\"file\": ");
+            bench_json_string(out, file);
+        } else {
+            fprintf(out, ",\n  \"corpus\": {\"mix\": ");
+            bench_json_string(out, mix_spec);
+            fprintf(out, ", \"seed\": %llu", cast(unsigned long long)seed);
+        }
+        fprintf(out, ", \"bytes\": %llu, \"tokens\": %u},\n", cast(unsigned long long)source->len, results[0].tokens);
+        fprintf(out, "  \"runs\": %u,\n", runs);
+        fprintf(out, "  \"warmup\": %u,\n", warmup);
+        fprintf(out, "  \"threads\": %u,\n", threads);
+        fprintf(out, "  \"seconds\": {\"min\": %.9f, \"median\": %.9f, \"mean\": %.9f, \"max\": %.9f},\n", seconds[0],
+                median, mean, seconds[runs - 1]);
+        fprintf(out, "  \"mb_per_s\": %.3f,\n", mb_per_s);
+        fprintf(out, "  \"tokens_per_s\": %.0f,\n", tokens_per_s);
+#ifdef ADORAD_BENCH_COUNT_ALLOCATIONS
+        fprintf(out, "  \"allocations_per_run\": %llu,\n", cast(unsigned long long)results[0].allocations);
+        fprintf(out, "  \"allocated_bytes_per_run\": %llu,\n", cast(unsigned long long)results[0].allocated_bytes);
+#else
+        fprintf(out, "  \"allocations_per_run\": null,\n");
+        fprintf(out, "  \"allocated_bytes_per_run\": null,\n");
+#endif // ADORAD_BENCH_COUNT_ALLOCATIONS
+        fprintf(out, "  \"peak_rss_bytes\": %llu,\n", cast(unsigned long long)peak_rss);
+        fprintf(out, "  \"run_seconds\": [");
+        for(UInt32 i = 0; i < runs; i++)
+            fprintf(out, "%s%.9f", i ? ", " : "", results[i].seconds);
+        fprintf(out, "]\n}\n");
+        if(out != stdout)
+            fclose(out);
+    }
+
+    free(seconds);
+    free(results);
+    file_unmap(source);
+    return 0;
+}
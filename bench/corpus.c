@@ -0,0 +1,402 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <adorad/core/debug.h>
+#include <bench/corpus.h>
+
+// The corpus being generated
+typedef struct Corpus {
+    char* data;
+    UInt64 len;
+    UInt64 cap;
+    UInt64 state;       // state of the (splitmix64) PRNG
+    const CorpusMix* mix;
+    UInt32 total;       // sum of the weights of `mix`
+    int depth;          // nesting depth of the current statement
+} Corpus;
+
+static const char* corpusMixNames[CORPUS_NUM_STMTS] = {
+    "idents", "numbers", "strings", "comments", "control", "unicode"
+};
+
+// A few names are far more common than the rest, as they are in real code (see `corpus_skewed()`)
+static const char* corpusNames[] = {
+    "count", "index", "value", "result", "buffer", "node", "item", "total", "offset", "len", "data", "name", "left",
+    "right", "parent", "size", "key", "entry", "state", "token", "lexer", "parser", "scope", "symbol", "table",
+    "cache", "file", "line", "col", "err", "self", "other", "next", "prev", "head", "tail", "first", "last"
+};
+static const char* corpusFuncs[] = {
+    "print", "append", "insert", "lookup", "compute", "update", "emit", "visit", "parse_expr", "resolve", "hash",
+    "format", "push", "pop", "read", "write"
+};
+static const char* corpusTypes[] = {
+    "Fruit", "Color", "Kind", "State", "Mode", "Shape", "Token", "Node", "Level", "Flag"
+};
+static const char* corpusUnicodeNames[] = {
+    "größe", "π", "café", "naïve", "Δx", "résumé", "σ", "θ", "über", "ñandú", "東京", "ключ"
+};
+static const char* corpusWords[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "lorem", "ipsum", "dolor", "sit", "amet",
+    "hello", "world", "value", "is", "not", "a", "number", "expected", "found", "at", "line"
+};
+static const char* corpusUnicodeWords[] = {
+    "café", "naïve", "über", "日本語", "привет", "γειά", "😀", "→", "©", "½"
+};
+static const char* corpusEscapes[] = {
+    "\\n", "\\t", "\\\"", "\\\\", "\\x41", "\\u{1F600}", "\\0", "\\r"
+};
+static const char* corpusBinaryOps[] = {
+    "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^", "&&", "||", "==", "!=", "<", "<=", ">", ">="
+};
+static const char* corpusAssignOps[] = {
+    "=", "=", "=", "+=", "-=", "*=", "|=", ":="
+};
+
+#define CORPUS_COUNT(array)     (sizeof(array) / sizeof((array)[0]))
+// Deepest nesting of `control` statements
+#define CORPUS_MAX_DEPTH        4
+
+bool corpus_parse_mix(const char* spec, CorpusMix* mix) {
+    memset(mix, 0, sizeof(CorpusMix));
+    if(strcmp(spec, "default") == 0) {
+        mix->weights[CORPUS_IDENTS] = 5;
+        mix->weights[CORPUS_NUMBERS] = 2;
+        mix->weights[CORPUS_STRINGS] = 2;
+        mix->weights[CORPUS_COMMENTS] = 2;
+        mix->weights[CORPUS_CONTROL] = 3;
+        return true;
+    }
+    for(UInt32 i = 0; i < CORPUS_NUM_STMTS; i++) {
+        if(strcmp(spec, corpusMixNames[i]) == 0) {
+            mix->weights[i] = 1;
+            return true;
+        }
+    }
+
+    // A list of weights: `name=weight[,name=weight...]`
+    UInt32 total = 0;
+    const char* p = spec;
+    while(*p) {
+        const char* eq = strchr(p, '=');
+        if(!eq)
+            return false;
+        Ll name_len = eq - p;
+        UInt32 i = 0;
+        while(i < CORPUS_NUM_STMTS && !(strlen(corpusMixNames[i]) == name_len &&
+                                         strncmp(p, corpusMixNames[i], name_len) == 0))
+            i++;
+        if(i == CORPUS_NUM_STMTS)
+            return false;
+
+        char* end;
+        unsigned long weight = strtoul(eq + 1, &end, 10);
+        if(end == eq + 1 || (*end != ',' && *end != nullchar))
+            return false;
+        mix->weights[i] = cast(UInt32)weight;
+        total += mix->weights[i];
+        p = *end == ',' ? end + 1 : end;
+    }
+    return total > 0;
+}
+
+// splitmix64
+static UInt64 corpus_rand(Corpus* corpus) {
+    UInt64 z = (corpus->state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// A random number in [0, n)
+static inline UInt32 corpus_below(Corpus* corpus, UInt32 n) {
+    return cast(UInt32)(corpus_rand(corpus) % n);
+}
+
+// A random number in [0, n), skewed towards 0
+static inline UInt32 corpus_skewed(Corpus* corpus, UInt32 n) {
+    return corpus_below(corpus, corpus_below(corpus, n) + 1);
+}
+
+#define CORPUS_PICK(corpus, array)      (array)[corpus_below(corpus, CORPUS_COUNT(array))]
+
+static void corpus_write(Corpus* corpus, const char* str, UInt64 len) {
+    if(corpus->len + len + 1 > corpus->cap) {
+        while(corpus->len + len + 1 > corpus->cap)
+            corpus->cap *= 2;
+        corpus->data = cast(char*)realloc(corpus->data, corpus->cap);
+        CORETEN_ENFORCE_NN(corpus->data, "Could not allocate memory. Memory full.");
+    }
+    memcpy(corpus->data + corpus->len, str, len);
+    corpus->len += len;
+}
+
+static inline void corpus_puts(Corpus* corpus, const char* str) {
+    corpus_write(corpus, str, strlen(str));
+}
+
+static void corpus_indent(Corpus* corpus) {
+    static const char spaces[] = "                                ";
+    corpus_write(corpus, spaces, 4 * (corpus->depth + 1));
+}
+
+static void corpus_name(Corpus* corpus) {
+    corpus_puts(corpus, corpusNames[corpus_skewed(corpus, CORPUS_COUNT(corpusNames))]);
+    if(corpus_below(corpus, 4) == 0) {
+        char suffix[16];
+        snprintf(suffix, sizeof(suffix), "_%u", corpus_skewed(corpus, 32));
+        corpus_puts(corpus, suffix);
+    }
+}
+
+static void corpus_number(Corpus* corpus) {
+    char number[64];
+    UInt32 a = corpus_skewed(corpus, 100000), b = corpus_below(corpus, 1000);
+    switch(corpus_below(corpus, 8)) {
+        case 0: snprintf(number, sizeof(number), "0x%X", a * 2654435761u); break;
+        case 1: snprintf(number, sizeof(number), "0b%u%u%u%u1", a & 1, b & 1, (a >> 1) & 1, (b >> 1) & 1); break;
+        case 2: snprintf(number, sizeof(number), "0o%o", a); break;
+        case 3: snprintf(number, sizeof(number), "%u.%u", a, b); break;
+        case 4: snprintf(number, sizeof(number), "%u.%ue%c%u", a % 10, b, b & 1 ? '+' : '-', b % 30); break;
+        case 5: snprintf(number, sizeof(number), "%u_%03u", a % 1000 + 1, b); break;
+        default: snprintf(number, sizeof(number), "%u", a % 256); break;
+    }
+    corpus_puts(corpus, number);
+}
+
+static void corpus_expr(Corpus* corpus, int depth);
+
+static void corpus_call(Corpus* corpus, int depth) {
+    corpus_puts(corpus, CORPUS_PICK(corpus, corpusFuncs));
+    corpus_puts(corpus, "(");
+    UInt32 args = corpus_below(corpus, 4);
+    for(UInt32 i = 0; i < args; i++) {
+        if(i > 0)
+            corpus_puts(corpus, ", ");
+        corpus_expr(corpus, depth + 1);
+    }
+    corpus_puts(corpus, ")");
+}
+
+static void corpus_operand(Corpus* corpus, int depth) {
+    UInt32 r = corpus_below(corpus, 10);
+    if(r < 5 || depth > 2) {
+        corpus_name(corpus);
+        if(r == 0) {
+            corpus_puts(corpus, ".");
+            corpus_name(corpus);
+        }
+    } else if(r < 8) {
+        corpus_number(corpus);
+    } else if(r == 8) {
+        corpus_call(corpus, depth);
+    } else {
+        corpus_puts(corpus, "(");
+        corpus_expr(corpus, depth + 1);
+        corpus_puts(corpus, ")");
+    }
+}
+
+static void corpus_expr(Corpus* corpus, int depth) {
+    corpus_operand(corpus, depth);
+    UInt32 ops = corpus_below(corpus, 3);
+    for(UInt32 i = 0; i < ops; i++) {
+        corpus_puts(corpus, " ");
+        corpus_puts(corpus, CORPUS_PICK(corpus, corpusBinaryOps));
+        corpus_puts(corpus, " ");
+        corpus_operand(corpus, depth);
+    }
+}
+
+// The contents of a STRING (without its quotes)
+static void corpus_string(Corpus* corpus, bool unicode) {
+    UInt32 words = 1 + corpus_below(corpus, 6);
+    for(UInt32 i = 0; i < words; i++) {
+        if(i > 0)
+            corpus_puts(corpus, " ");
+        if(unicode && corpus_below(corpus, 2) == 0)
+            corpus_puts(corpus, CORPUS_PICK(corpus, corpusUnicodeWords));
+        else
+            corpus_puts(corpus, CORPUS_PICK(corpus, corpusWords));
+    }
+    if(corpus_below(corpus, 4) == 0)
+        corpus_puts(corpus, CORPUS_PICK(corpus, corpusEscapes));
+}
+
+static void corpus_block(Corpus* corpus, UInt32 min, UInt32 max);
+
+static void corpus_statement(Corpus* corpus) {
+    UInt32 r = corpus_below(corpus, corpus->total);
+    UInt32 kind = 0;
+    while(r >= corpus->mix->weights[kind]) {
+        r -= corpus->mix->weights[kind];
+        kind++;
+    }
+    if(kind == CORPUS_CONTROL && corpus->depth >= CORPUS_MAX_DEPTH)
+        kind = CORPUS_IDENTS;
+
+    corpus_indent(corpus);
+    switch(kind) {
+        case CORPUS_IDENTS:
+            if(corpus_below(corpus, 3) == 0) {
+                corpus_call(corpus, 0);
+            } else {
+                corpus_name(corpus);
+                corpus_puts(corpus, " ");
+                corpus_puts(corpus, CORPUS_PICK(corpus, corpusAssignOps));
+                corpus_puts(corpus, " ");
+                corpus_expr(corpus, 0);
+            }
+            break;
+        case CORPUS_NUMBERS:
+            corpus_name(corpus);
+            corpus_puts(corpus, " = ");
+            corpus_number(corpus);
+            for(UInt32 i = corpus_below(corpus, 4); i > 0; i--) {
+                corpus_puts(corpus, " ");
+                corpus_puts(corpus, corpusBinaryOps[corpus_below(corpus, 5)]);
+                corpus_puts(corpus, " ");
+                corpus_number(corpus);
+            }
+            break;
+        case CORPUS_STRINGS:
+            corpus_puts(corpus, CORPUS_PICK(corpus, corpusFuncs));
+            corpus_puts(corpus, "(\"");
+            corpus_string(corpus, false);
+            corpus_puts(corpus, "\"");
+            if(corpus_below(corpus, 2) == 0) {
+                corpus_puts(corpus, ", ");
+                corpus_name(corpus);
+            }
+            corpus_puts(corpus, ")");
+            break;
+        case CORPUS_COMMENTS:
+            switch(corpus_below(corpus, 3)) {
+                case 0: corpus_puts(corpus, "# "); corpus_string(corpus, false); break;
+                case 1: corpus_puts(corpus, "// "); corpus_string(corpus, false); break;
+                default:
+                    corpus_puts(corpus, "/* ");
+                    corpus_string(corpus, false);
+                    corpus_puts(corpus, "\n");
+                    corpus_indent(corpus);
+                    corpus_puts(corpus, "   ");
+                    corpus_string(corpus, false);
+                    corpus_puts(corpus, " */");
+                    break;
+            }
+            break;
+        case CORPUS_CONTROL:
+            switch(corpus_below(corpus, 3)) {
+                case 0:
+                    corpus_puts(corpus, "if ");
+                    corpus_expr(corpus, 0);
+                    corpus_block(corpus, 1, 4);
+                    if(corpus_below(corpus, 2) == 0) {
+                        corpus_puts(corpus, " else");
+                        corpus_block(corpus, 1, 3);
+                    }
+                    break;
+                case 1:
+                    corpus_puts(corpus, "for ");
+                    corpus_name(corpus);
+                    corpus_puts(corpus, " in range(");
+                    corpus_number(corpus);
+                    corpus_puts(corpus, ")");
+                    corpus_block(corpus, 1, 4);
+                    break;
+                default:
+                    corpus_puts(corpus, "while ");
+                    corpus_expr(corpus, 0);
+                    corpus_block(corpus, 1, 4);
+                    break;
+            }
+            break;
+        default:
+            corpus_puts(corpus, CORPUS_PICK(corpus, corpusUnicodeNames));
+            corpus_puts(corpus, " := \"");
+            corpus_string(corpus, true);
+            corpus_puts(corpus, "\"");
+            break;
+    }
+    corpus_puts(corpus, "\n");
+}
+
+// A `{ ... }` block of between `min` and `max` statements (the closing brace isn't followed by a newline)
+static void corpus_block(Corpus* corpus, UInt32 min, UInt32 max) {
+    corpus_puts(corpus, " {\n");
+    corpus->depth++;
+    for(UInt32 i = min + corpus_below(corpus, max - min + 1); i > 0; i--)
+        corpus_statement(corpus);
+    corpus->depth--;
+    corpus_indent(corpus);
+    corpus_puts(corpus, "}");
+}
+
+static void corpus_declaration(Corpus* corpus) {
+    UInt32 r = corpus_below(corpus, 20);
+    if(r == 0) {
+        corpus_puts(corpus, "import ");
+        corpus_name(corpus);
+        corpus_puts(corpus, "\n\n");
+    } else if(r == 1) {
+        corpus_puts(corpus, "type ");
+        corpus_puts(corpus, CORPUS_PICK(corpus, corpusTypes));
+        corpus_puts(corpus, " enum {\n");
+        for(UInt32 i = 2 + corpus_below(corpus, 5); i > 0; i--) {
+            corpus_puts(corpus, "    ");
+            corpus_puts(corpus, CORPUS_PICK(corpus, corpusTypes));
+            corpus_puts(corpus, i > 1 ? ",\n" : "\n");
+        }
+        corpus_puts(corpus, "}\n\n");
+    } else {
+        corpus_puts(corpus, "func ");
+        corpus_name(corpus);
+        corpus_puts(corpus, "(");
+        for(UInt32 i = corpus_below(corpus, 4); i > 0; i--) {
+            corpus_name(corpus);
+            corpus_puts(corpus, i > 1 ? ", " : "");
+        }
+        corpus_puts(corpus, ") {\n");
+        for(UInt32 i = 3 + corpus_below(corpus, 10); i > 0; i--)
+            corpus_statement(corpus);
+        corpus_puts(corpus, "}\n\n");
+    }
+}
+
+char* corpus_generate(UInt64 size, const CorpusMix* mix, UInt64 seed, UInt64* len) {
+    Corpus corpus = {0};
+    corpus.cap = size + 4096;
+    corpus.data = cast(char*)malloc(corpus.cap);
+    CORETEN_ENFORCE_NN(corpus.data, "Could not allocate memory. Memory full.");
+    corpus.state = seed;
+    corpus.mix = mix;
+    for(UInt32 i = 0; i < CORPUS_NUM_STMTS; i++)
+        corpus.total += mix->weights[i];
+    CORETEN_ENFORCE(corpus.total > 0, "A corpus mix needs at least one non-zero weight");
+
+    // Stop at the last declaration that fits
+    while(corpus.len < size) {
+        UInt64 last = corpus.len;
+        corpus_declaration(&corpus);
+        if(corpus.len > size && last > 0) {
+            corpus.len = last;
+            break;
+        }
+    }
+
+    corpus.data[corpus.len] = nullchar;
+    *len = corpus.len;
+    return corpus.data;
+}
@@ -0,0 +1,54 @@
+/*
+          _____   ____  _____            _____
+    /\   |  __ \ / __ \|  __ \     /\   |  __ \
+   /  \  | |  | | |  | | |__) |   /  \  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\ \ | |  | | |  | |  _  /   / /\ \ | |  | | Languages: C, C++, and Assembly
+ / ____ \| |__| | |__| | | \ \  / ____ \| |__| | https://github.com/adorad/adorad/
+/_/    \_\_____/ \____/|_|  \_\/_/    \_\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+#ifndef ADORAD_BENCH_CORPUS_H
+#define ADORAD_BENCH_CORPUS_H
+
+#include <adorad/core/types.h>
+
+/*
+    Synthetic corpus generator
+    Generates Adorad source (imports, enums and functions made up of statements) for the benchmarks. The output
+    depends only on the requested size, the mix and the seed, so the same corpus can be regenerated anywhere (and
+    at any size, from a few KB up to a GB) instead of being checked in.
+
+    A mix weighs the kinds of statements that make up function bodies, which is what decides the token mix:
+        idents      assignments and calls over (frequently repeated) identifiers and operators
+        numbers     arithmetic over integer, hex, binary, octal and float literals
+        strings     calls with STRING arguments (a few of them with escape sequences)
+        comments    line (`#` and `//`) and block comments
+        control     nested `if`/`else`, `for` and `while` blocks
+        unicode     identifiers and STRINGs with non-ASCII characters
+*/
+
+typedef enum CorpusStmt {
+    CORPUS_IDENTS = 0,
+    CORPUS_NUMBERS,
+    CORPUS_STRINGS,
+    CORPUS_COMMENTS,
+    CORPUS_CONTROL,
+    CORPUS_UNICODE,
+    CORPUS_NUM_STMTS
+} CorpusStmt;
+
+typedef struct CorpusMix {
+    UInt32 weights[CORPUS_NUM_STMTS];   // relative weight of each kind of statement
+} CorpusMix;
+
+// Parse a mix: either a preset (`default`, `idents`, `numbers`, `strings`, `comments`, `control` or `unicode`) or
+// a list of weights such as `idents=3,strings=1` (unlisted kinds weigh 0). Returns false if `spec` is invalid
+bool corpus_parse_mix(const char* spec, CorpusMix* mix);
+// Generate a corpus of at most `size` bytes (as many whole top-level declarations as fit, but at least one). The
+// result is NUL-terminated, must be freed, and its length is stored in `len`
+char* corpus_generate(UInt64 size, const CorpusMix* mix, UInt64 seed, UInt64* len);
+
+#endif // ADORAD_BENCH_CORPUS_H
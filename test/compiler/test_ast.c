@@ -0,0 +1,48 @@
+#include <AdoradInternalTests/AdoradInternalTests.h>
+#include <tau/tau.h>
+TAU_MAIN()
+
+TEST(Ast, flat) {
+    // `f(a + b, c)`
+    FlatAst* ast = flatast_new(1);
+    AstIndex f = flatast_push(ast, AstNodeKindIdentifier, 0, AST_NONE, AST_NONE);
+    AstIndex a = flatast_push(ast, AstNodeKindIdentifier, 2, AST_NONE, AST_NONE);
+    AstIndex b = flatast_push(ast, AstNodeKindIdentifier, 4, AST_NONE, AST_NONE);
+    AstIndex sum = flatast_push(ast, AstNodeKindBinaryOpExpr, 3, a, b);
+    AstIndex c = flatast_push(ast, AstNodeKindIdentifier, 6, AST_NONE, AST_NONE);
+    AstIndex args[] = { sum, c };
+    AstIndex call = flatast_push(ast, AstNodeKindFuncCallExpr, 1, f, flatast_push_list(ast, args, 2));
+    CHECK_EQ(ast->size, 6);
+
+    FlatAstNode node = flatast_at(ast, call);
+    CHECK_EQ(node.kind, AstNodeKindFuncCallExpr);
+    CHECK_EQ(node.lhs, f);
+    UInt32 count = 0;
+    const AstIndex* list = flatast_list(ast, node.rhs, &count);
+    CHECK_EQ(count, 2);
+    CHECK_EQ(list[0], sum);
+    CHECK_EQ(list[1], c);
+    CHECK_EQ(flatast_at(ast, list[0]).rhs, b);
+
+    // The arrays are the serialized form
+    FILE* file = tmpfile();
+    CHECK(flatast_write(ast, file));
+    long len = ftell(file);
+    char* data = cast(char*)malloc(len);
+    rewind(file);
+    CHECK_EQ(fread(data, 1, len, file), len);
+    fclose(file);
+
+    FlatAst* copy = flatast_read(data, len);
+    CHECK(copy != null);
+    CHECK_EQ(copy->size, ast->size);
+    CHECK_EQ(copy->num_extra, ast->num_extra);
+    CHECK(memcmp(copy->kinds, ast->kinds, ast->size) == 0);
+    CHECK(memcmp(copy->lhs, ast->lhs, ast->size * sizeof(UInt32)) == 0);
+    CHECK(memcmp(copy->extra_data, ast->extra_data, ast->num_extra * sizeof(UInt32)) == 0);
+    CHECK(flatast_read(data, len - 1) == null);
+
+    free(data);
+    flatast_free(copy);
+    flatast_free(ast);
+}
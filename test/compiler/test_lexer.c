@@ -1,5 +1,8 @@
 #include <AdoradInternalTests/AdoradInternalTests.h>
 #include <tau/tau.h>
+#if defined(CORETEN_OS_UNIX)
+    #include <sys/stat.h>
+#endif // CORETEN_OS_UNIX
 TAU_MAIN()
  
 TEST(Lexer, Init) {
@@ -8,8 +11,8 @@ TEST(Lexer, Init) {
 
     CHECK_STRNE(lexer->buffer->data, "");
     CHECK_EQ(lexer->buffer->len, strlen(buffer));
-    CHECK_EQ(vec_cap(lexer->toklist), TOKENLIST_ALLOC_CAPACITY);
-    CHECK_EQ(vec_size(lexer->toklist), 0);
+    CHECK_EQ(lexer->toklist->cap, TOKENLIST_ALLOC_CAPACITY);
+    CHECK_EQ(lexer->toklist->size, 0);
     CHECK_EQ(lexer->offset, 0);
     CHECK_EQ(lexer->loc->line, 1);
     CHECK_EQ(lexer->loc->col, 1);
@@ -18,6 +21,479 @@ TEST(Lexer, Init) {
     free(lexer);
 }
 
+TEST(Lexer, presized_toklist) {
+    // Large buffers get room for all of their tokens upfront
+    const char* line = "count := count + 1  # bump \"it\"\n";
+    UInt32 num_lines = 4096;
+    char* buffer = cast(char*)malloc(num_lines * strlen(line) + 1);
+    for(UInt32 i = 0; i < num_lines; i++)
+        memcpy(buffer + i * strlen(line), line, strlen(line));
+    buffer[num_lines * strlen(line)] = nullchar;
+
+    Lexer* lexer = lexer_init(buffer, null);
+    UInt32 cap = lexer->toklist->cap;
+    CHECK(cap > TOKENLIST_ALLOC_CAPACITY);
+    lexer_lex(lexer);
+    CHECK_EQ(lexer->toklist->size, num_lines * 7 + 1);
+    CHECK_EQ(lexer->toklist->cap, cap);
+
+    tokenlist_reserve(lexer->toklist, 2 * cap);
+    CHECK_EQ(lexer->toklist->cap, 2 * cap);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 7).offset, strlen(line));
+    lexer_free(lexer);
+    free(buffer);
+}
+
+TEST(Lexer, token_spans) {
+    char* buffer = "atomic x = \"str\";";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+
+    // Tokens are views into `lexer->buffer`
+    Token tok = tokenlist_at(lexer->toklist, 1);
+    CHECK(tok.kind == IDENTIFIER);
+    CHECK_EQ(tok.offset, 7);
+    CHECK_EQ(tok.len, 1);
+
+    // Strings exclude the quotes
+    tok = tokenlist_at(lexer->toklist, 3);
+    CHECK(tok.kind == STRING);
+    CHECK_EQ(tok.offset, 12);
+    CHECK_EQ(tok.len, 3);
+    CHECK_STREQ(lexer_token_value(lexer, &tok)->data, "str");
+
+    tok = tokenlist_at(lexer->toklist, 5);
+    CHECK(tok.kind == TOK_EOF);
+    CHECK_EQ(tok.len, 0);
+
+    // Locations are computed on request
+    Location loc = lexer_location(lexer, tok.offset);
+    CHECK_EQ(loc.line, 1);
+    CHECK_EQ(loc.col, 18);
+
+    lexer_free(lexer);
+}
+
+TEST(Lexer, keywords) {
+    char* buffer = "while where whilex fallthrough as a elseif";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+
+    CHECK(tokenlist_at(lexer->toklist, 0).kind == WHILE);
+    CHECK(tokenlist_at(lexer->toklist, 1).kind == WHERE);
+    CHECK(tokenlist_at(lexer->toklist, 2).kind == IDENTIFIER);
+    CHECK(tokenlist_at(lexer->toklist, 3).kind == FALLTHROUGH);
+    CHECK(tokenlist_at(lexer->toklist, 4).kind == AS);
+    CHECK(tokenlist_at(lexer->toklist, 5).kind == IDENTIFIER);
+    CHECK(tokenlist_at(lexer->toklist, 6).kind == ELSEIF);
+
+    lexer_free(lexer);
+}
+
+TEST(Lexer, operators) {
+    char* buffer = "!a != b <<= ... .. ->{}";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+
+    CHECK(tokenlist_at(lexer->toklist, 0).kind == EXCLAMATION);
+    CHECK(tokenlist_at(lexer->toklist, 2).kind == EXCLAMATION_EQUALS);
+    CHECK(tokenlist_at(lexer->toklist, 4).kind == LBITSHIFT_EQUALS);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 4).len, 3);
+    CHECK(tokenlist_at(lexer->toklist, 5).kind == ELLIPSIS);
+    CHECK(tokenlist_at(lexer->toklist, 6).kind == DDOT);
+    CHECK(tokenlist_at(lexer->toklist, 7).kind == RARROW);
+    CHECK(tokenlist_at(lexer->toklist, 8).kind == LBRACE);
+    CHECK(tokenlist_at(lexer->toklist, 9).kind == RBRACE);
+    CHECK_EQ(lexer->nest_level, 0);
+
+    lexer_free(lexer);
+}
+
+TEST(Lexer, relex) {
+    char* buffer = "a = 1\nb = \"s\"\n{ c = 3 }";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+    UInt32 size = lexer->toklist->size;
+
+    // `b` --> `bcd {`
+    lexer_relex(lexer, 6, 1, "bcd {");
+    CHECK_STREQ(lexer->buffer->data, "a = 1\nbcd { = \"s\"\n{ c = 3 }");
+    CHECK_EQ(lexer->toklist->size, size + 1);
+    CHECK(tokenlist_at(lexer->toklist, 3).kind == IDENTIFIER);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 3).len, 3);
+    CHECK(tokenlist_at(lexer->toklist, 4).kind == LBRACE);
+    CHECK_EQ(lexer->nest_level, 1);
+
+    // Tokens after the edit are shifted
+    Token tok = tokenlist_at(lexer->toklist, 6);
+    CHECK(tok.kind == STRING);
+    CHECK_EQ(tok.offset, 15);
+    tok = tokenlist_at(lexer->toklist, lexer->toklist->size - 1);
+    CHECK(tok.kind == TOK_EOF);
+    CHECK_EQ(tok.offset, 27);
+
+    // `a` --> `"x"`
+    lexer_relex(lexer, 0, 1, "\"x\"");
+    CHECK(tokenlist_at(lexer->toklist, 0).kind == STRING);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 0).len, 1);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 1).offset, 4);
+
+    lexer_free(lexer);
+}
+
+TEST(Lexer, streaming) {
+    char* buffer = "func f(a, b) { return a + b * 2 } // comment\n@macro \"str\"";
+    Lexer* full = lexer_init(buffer, null);
+    lexer_lex(full);
+
+    Lexer* lexer = lexer_init_streaming(buffer, null, 4);
+    TokenIndex index;
+    do {
+        index = lexer_next_token(lexer);
+        Token expected = tokenlist_at(full->toklist, index);
+        Token tok = tokenlist_at(lexer->toklist, index);
+        CHECK(tok.kind == expected.kind);
+        CHECK_EQ(tok.offset, expected.offset);
+        CHECK_EQ(tok.len, expected.len);
+    } while(tokenlist_at(lexer->toklist, index).kind != TOK_EOF);
+
+    // Only the last 4 tokens are held
+    CHECK_EQ(lexer->toklist->size, full->toklist->size);
+    CHECK_EQ(lexer->toklist->cap, 4);
+    CHECK_EQ(lexer->toklist->base, full->toklist->size - 4);
+    CHECK_EQ(lexer_next_token(lexer), index);
+
+    lexer_free(full);
+    lexer_free(lexer);
+}
+
+TEST(Lexer, parallel) {
+    // Large enough to be split into chunks. Strings and comments span lines, so some chunks begin inside them
+    const char* snippet = "func f(a) {\n    s := \"$\n    \"\n    /* { \n \" */ return a // c\n}\n";
+    UInt32 snippet_len = cast(UInt32)strlen(snippet);
+    UInt32 count = (4 * LEXER_PARALLEL_MIN_CHUNK) / snippet_len + 1;
+    char* buffer = cast(char*)malloc(count * snippet_len + 1);
+    for(UInt32 i = 0; i < count; i++)
+        memcpy(buffer + i * snippet_len, snippet, snippet_len);
+    buffer[count * snippet_len] = nullchar;
+
+    Lexer* sequential = lexer_init(buffer, null);
+    lexer_lex(sequential);
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex_parallel(lexer, 4);
+
+    CHECK_EQ(lexer->toklist->size, sequential->toklist->size);
+    for(TokenIndex i = 0; i < sequential->toklist->size; i++) {
+        Token expected = tokenlist_at(sequential->toklist, i);
+        Token tok = tokenlist_at(lexer->toklist, i);
+        CHECK(tok.kind == expected.kind);
+        CHECK_EQ(tok.offset, expected.offset);
+        CHECK_EQ(tok.len, expected.len);
+    }
+    CHECK_EQ(lexer->nest_level, sequential->nest_level);
+    CHECK_EQ(lexer->offset, sequential->offset);
+
+    lexer_free(sequential);
+    lexer_free(lexer);
+    free(buffer);
+}
+
+TEST(Lexer, mapped) {
+    // The CWD for the tests is the root of the repository
+    FileMap* file = file_map("test/LexerDemo.ad");
+    char* buffer = readFile("test/LexerDemo.ad");
+    CHECK_EQ(file->len, strlen(buffer));
+    CHECK_EQ(file->contents[file->len], nullchar);
+
+    Lexer* expected = lexer_init(buffer, null);
+    lexer_lex(expected);
+    Lexer* lexer = lexer_init_mapped(file, null);
+    lexer_lex(lexer);
+
+    CHECK_EQ(lexer->toklist->size, expected->toklist->size);
+    for(TokenIndex i = 0; i < expected->toklist->size; i++) {
+        CHECK(tokenlist_at(lexer->toklist, i).kind == tokenlist_at(expected->toklist, i).kind);
+        CHECK_EQ(tokenlist_at(lexer->toklist, i).offset, tokenlist_at(expected->toklist, i).offset);
+    }
+
+    lexer_free(expected);
+    lexer_free(lexer);
+    file_unmap(file);
+    free(buffer);
+}
+
+TEST(Lexer, interning) {
+    // Every spelling of a name gets a single Atom - keywords and other tokens get none
+    char* buffer = "count = count + other_count_1; while @count other_count_2";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+
+    Atom count = tokenlist_at(lexer->toklist, 0).atom;
+    CHECK(count != ATOM_NONE);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 1).atom, ATOM_NONE);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 2).atom, count);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 6).atom, ATOM_NONE);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 7).atom, count);
+    // These differ only in their 13th byte
+    CHECK(tokenlist_at(lexer->toklist, 4).atom != tokenlist_at(lexer->toklist, 8).atom);
+
+    UInt32 len;
+    CHECK_STREQ(interner_spelling(lexer->interner, count, &len), "count");
+    CHECK_EQ(len, 5);
+
+    // A shared Interner gives a name the same Atom in every file
+    Lexer* other = lexer_init("x := count", null);
+    lexer_use_interner(other, lexer->interner);
+    lexer_lex(other);
+    CHECK_EQ(tokenlist_at(other->toklist, 3).atom, count);
+    lexer_free(other);
+
+    // Enough names to grow the table a few times
+    Interner* interner = interner_new();
+    char name[16];
+    for(int i = 0; i < 5000; i++) {
+        sprintf(name, "name_%d", i);
+        CHECK_EQ(interner_intern(interner, name, cast(UInt32)strlen(name)), cast(Atom)(i + 1));
+    }
+    CHECK_EQ(interner_intern(interner, "name_1234", 9), 1235);
+    interner_free(interner);
+    lexer_free(lexer);
+}
+
+TEST(Lexer, token_cache) {
+    char* buffer = "func main() {\n    x := \"a\\tb\"\n    @inline y = x + 0x1f\n}\n";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+    CHECK(lexer_cache_save(lexer, "."));
+
+    Lexer* cached = lexer_init(buffer, null);
+    CHECK(lexer_cache_load(cached, "."));
+    CHECK_EQ(cached->toklist->size, lexer->toklist->size);
+    for(TokenIndex i = 0; i < lexer->toklist->size; i++) {
+        Token a = tokenlist_at(lexer->toklist, i);
+        Token b = tokenlist_at(cached->toklist, i);
+        CHECK_EQ(a.kind, b.kind);
+        CHECK_EQ(a.offset, b.offset);
+        CHECK_EQ(a.len, b.len);
+        CHECK_EQ(a.atom, b.atom);
+    }
+    UInt32 len;
+    Token string = tokenlist_at(cached->toklist, 8);
+    CHECK_EQ(string.kind, STRING);
+    CHECK_STREQ(lexer_string_value(cached, &string, &len), "a\tb");
+    CHECK_EQ(lexer_location(cached, tokenlist_at(cached->toklist, 9).offset).line, 3);
+    CHECK_EQ(cached->offset, lexer->offset);
+
+    // Any change to the source misses the cache
+    Lexer* changed = lexer_init("func main() {}\n", null);
+    CHECK(!lexer_cache_load(changed, "."));
+    CHECK_EQ(changed->toklist->size, 0);
+
+    char path[64];
+    sprintf(path, "./%016llx.adtok", cast(unsigned long long)hash_murmur64(buffer, strlen(buffer)));
+    CHECK_EQ(remove(path), 0);
+
+    // So does an entry that can't be opened (`file_map()` would exit)...
+    CHECK_NULL(file_try_map("./no-such-dir/cache.adtok"));
+#if defined(CORETEN_OS_UNIX)
+    // ... or read (here, a directory in its place)
+    CHECK_EQ(mkdir(path, 0700), 0);
+    Lexer* unreadable = lexer_init(buffer, null);
+    CHECK(!lexer_cache_load(unreadable, "."));
+    CHECK_EQ(unreadable->toklist->size, 0);
+    CHECK_EQ(remove(path), 0);
+    lexer_free(unreadable);
+#endif // CORETEN_OS_UNIX
+    lexer_free(changed);
+    lexer_free(cached);
+    lexer_free(lexer);
+}
+
+TEST(Lexer, string_escapes) {
+    // A STRING without escape sequences is a view into the Lexical buffer; one with escape sequences is decoded.
+    // Both are longer than a SIMD block
+    char* buffer = "\"no escapes in this string, which is longer than a block\" "
+                   "\"tab\\t quote\\\" \\x41\\u{e9}\\u{1F600} backslash\\\\ and a newline\\n\"";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+
+    UInt32 len;
+    Token tok = tokenlist_at(lexer->toklist, 0);
+    CHECK(lexer_string_value(lexer, &tok, &len) == lexer->buffer->data + tok.offset);
+    CHECK_EQ(len, tok.len);
+
+    tok = tokenlist_at(lexer->toklist, 1);
+    CHECK(tok.kind == STRING);
+    const char* value = lexer_string_value(lexer, &tok, &len);
+    CHECK_STREQ(value, "tab\t quote\" A\xc3\xa9\xf0\x9f\x98\x80 backslash\\ and a newline\n");
+    CHECK_EQ(len, strlen(value));
+    CHECK_STREQ(lexer_token_value(lexer, &tok)->data, value);
+    lexer_free(lexer);
+}
+
+TEST(Lexer, utf8) {
+    // The source is validated before it is lexed. Longer than a SIMD block, with sequences crossing block boundaries
+    char* valid = "s = \"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 ..............................\xe2\x82\xac\"";
+    CHECK_EQ(utf8_validate(valid, strlen(valid)), strlen(valid));
+    Lexer* lexer = lexer_init(valid, null);
+    lexer_lex(lexer);
+    CHECK(tokenlist_at(lexer->toklist, 2).kind == STRING);
+    lexer_free(lexer);
+
+    // Stray continuation byte, overlong encoding, surrogate, truncated sequence
+    CHECK_EQ(utf8_validate("................................\x80", 33), 32);
+    CHECK_EQ(utf8_validate("..\xc0\x80", 4), 2);
+    CHECK_EQ(utf8_validate("\xed\xa0\x80", 3), 0);
+    CHECK_EQ(utf8_validate("...............................\xe2\x82", 33), 31);
+}
+
+TEST(Lexer, unicode_identifiers) {
+    // `größe`, `日本語_1` and an ASCII identifier long enough to cross a SIMD block, followed by a non-ASCII letter
+    // and a combining mark (XID_Continue, but not XID_Start)
+    char* buffer = "gr\xc3\xb6\xc3\x9f" "e = \xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e_1 + "
+                   "abcdefghijklmnopqrstuvwxyz_0123456789\xc3\xa9\xcc\x81";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+
+    Token t = tokenlist_at(lexer->toklist, 0);
+    CHECK(t.kind == IDENTIFIER);
+    CHECK_EQ(t.len, 7);
+    t = tokenlist_at(lexer->toklist, 2);
+    CHECK(t.kind == IDENTIFIER);
+    CHECK_EQ(t.len, 11);
+    t = tokenlist_at(lexer->toklist, 4);
+    CHECK(t.kind == IDENTIFIER);
+    CHECK_EQ(t.len, 41);
+    CHECK(tokenlist_at(lexer->toklist, 5).kind == TOK_EOF);
+    lexer_free(lexer);
+
+    CHECK(utf8_is_xid_start(0x00E9));
+    CHECK(!utf8_is_xid_start(0x0301));
+    CHECK(utf8_is_xid_continue(0x0301));
+    CHECK(!utf8_is_xid_continue(0x20AC));
+}
+
+TEST(Lexer, whitespace_runs) {
+    // Runs longer than a SIMD block, with newlines on either side of the block boundaries
+    char* buffer = "a                     \n\n   \t  \n                          abcdefghijklmnopqrstuvwxyz_0123456789ABC\n"
+                   "// a comment that is longer than thirty-two characters\n    b";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+
+    CHECK_EQ(lexer->toklist->size, 5);
+    Token tok = tokenlist_at(lexer->toklist, 1);
+    CHECK(tok.kind == IDENTIFIER);
+    CHECK_EQ(tok.len, 40);
+    CHECK(tokenlist_at(lexer->toklist, 2).kind == COMMENT);
+    CHECK_EQ(tokenlist_at(lexer->toklist, 2).len, 52);
+
+    // Line/col are computed from the offsets of the newlines
+    Location loc = lexer_location(lexer, tok.offset);
+    CHECK_EQ(loc.line, 4);
+    CHECK_EQ(loc.col, 27);
+    loc = lexer_location(lexer, lexer->offset);
+    CHECK_EQ(loc.line, 6);
+    CHECK_EQ(loc.col, 6);
+    CHECK_EQ(lexer->num_lines, 6);
+
+    lexer_free(lexer);
+}
+
+TEST(Lexer, trivia) {
+    char* buffer = "#!/bin/adorad\nx = 1 // one\n/* a\n * block */ y # two\n";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_set_trivia(lexer, LEXER_TRIVIA_ALL);
+    lexer_lex(lexer);
+
+    // Comments are kept out of the token stream
+    CHECK_EQ(lexer->toklist->size, 5);
+    CHECK(tokenlist_at(lexer->toklist, 3).kind == IDENTIFIER);
+
+    // `y` is preceded by a space, `// one` (without its newline), a newline, the block comment and a space
+    UInt32 count;
+    const LexerTrivia* trivia = lexer_token_trivia(lexer, 3, &count);
+    CHECK_EQ(count, 5);
+    CHECK_EQ(trivia[1].kind, TRIVIA_LINE_COMMENT);
+    CHECK_EQ(trivia[1].offset, 20);
+    CHECK_EQ(trivia[1].len, 6);
+    CHECK_EQ(trivia[2].kind, TRIVIA_WHITESPACE);
+    CHECK_EQ(trivia[3].kind, TRIVIA_BLOCK_COMMENT);
+    CHECK_EQ(trivia[3].len, 16);
+    // The shebang is a line comment
+    trivia = lexer_token_trivia(lexer, 0, &count);
+    CHECK_EQ(count, 2);
+    CHECK_EQ(trivia[0].kind, TRIVIA_LINE_COMMENT);
+    CHECK_EQ(trivia[0].len, 13);
+
+    // The tokens and the trivia cover the entire buffer
+    UInt32 offset = 0;
+    for(TokenIndex i = 0; i < lexer->toklist->size; i++) {
+        trivia = lexer_token_trivia(lexer, i, &count);
+        for(UInt32 j = 0; j < count; j++) {
+            CHECK_EQ(trivia[j].offset, offset);
+            offset += trivia[j].len;
+        }
+        CHECK_EQ(tokenlist_at(lexer->toklist, i).offset, offset);
+        offset += tokenlist_at(lexer->toklist, i).len;
+    }
+    CHECK_EQ(offset, strlen(buffer));
+
+    // Relexing keeps the trivia after the edit keyed by the right tokens
+    lexer_relex(lexer, 4, 1, "xyz");
+    trivia = lexer_token_trivia(lexer, 3, &count);
+    CHECK_EQ(count, 5);
+    CHECK_EQ(trivia[1].offset, 22);
+
+    lexer_free(lexer);
+}
+
+TEST(Lexer, int_literals) {
+    char* buffer = "1_000_000 0xdead_BEEF 0o17 0b1010 12345678901234567890123 1.5 "
+                   "340282366920938463463374607431768211455 340282366920938463463374607431768211456 "
+                   "0x1_0000_0000_0000_0000_0000_0000_0000_0000";
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_set_decode_ints(lexer, true);
+    lexer_lex(lexer);
+
+    Token tok = tokenlist_at(lexer->toklist, 0);
+    const LexerInt* value = lexer_int_value(lexer, &tok);
+    CHECK_EQ(value->lo, 1000000);
+    CHECK_EQ(value->hi, 0);
+    tok = tokenlist_at(lexer->toklist, 1);
+    CHECK_EQ(lexer_int_value(lexer, &tok)->lo, 0xDEADBEEF);
+    tok = tokenlist_at(lexer->toklist, 2);
+    CHECK_EQ(lexer_int_value(lexer, &tok)->lo, 15);
+    tok = tokenlist_at(lexer->toklist, 3);
+    CHECK_EQ(lexer_int_value(lexer, &tok)->lo, 10);
+
+    // Wider than 64 bits
+    tok = tokenlist_at(lexer->toklist, 4);
+    value = lexer_int_value(lexer, &tok);
+    CHECK(!value->overflow);
+    CHECK_EQ(value->hi, 0x29D);
+    CHECK_EQ(value->lo, 0x42B64E76714244CBULL);
+
+    // The largest 128-bit value, and the ones right after it
+    tok = tokenlist_at(lexer->toklist, 6);
+    value = lexer_int_value(lexer, &tok);
+    CHECK(!value->overflow);
+    CHECK_EQ(value->hi, ~0ULL);
+    CHECK_EQ(value->lo, ~0ULL);
+    tok = tokenlist_at(lexer->toklist, 7);
+    CHECK(lexer_int_value(lexer, &tok)->overflow);
+    tok = tokenlist_at(lexer->toklist, 8);
+    CHECK(lexer_int_value(lexer, &tok)->overflow);
+    CHECK_EQ(lexer->num_ints, 8);
+    lexer_free(lexer);
+
+    // Integer literals are only decoded on request
+    lexer = lexer_init("42", null);
+    lexer_lex(lexer);
+    tok = tokenlist_at(lexer->toklist, 0);
+    CHECK(lexer_int_value(lexer, &tok) == null);
+    lexer_free(lexer);
+}
+
 // // Without newline in buffer
 // TEST(Lexer, advance_without_newline) {
 //     char* buffer = "abcdefghijklmnopqrstuvwxyz0123456789";
@@ -0,0 +1,87 @@
+#include <AdoradInternalTests/AdoradInternalTests.h>
+#include <tau/tau.h>
+#include <math.h>
+TAU_MAIN()
+
+static Float64 parse_f64(const char* literal) {
+    Float64 value = -1;
+    CHECK(number_parse_f64(literal, strlen(literal), &value));
+    return value;
+}
+
+static Float32 parse_f32(const char* literal) {
+    Float32 value = -1;
+    CHECK(number_parse_f32(literal, strlen(literal), &value));
+    return value;
+}
+
+TEST(Number, syntax) {
+    CHECK_EQ(parse_f64("1_000.000_5"), 1000.0005);
+    CHECK_EQ(parse_f64("1_0e1_0"), 1e11);
+    CHECK_EQ(parse_f32("6.02_214e2_3"), 6.02214e23f);
+    CHECK_EQ(parse_f64(".5"), 0.5);
+    CHECK_EQ(parse_f64("1."), 1.0);
+    CHECK_EQ(parse_f64("2.5E-3"), 2.5e-3);
+    CHECK_EQ(parse_f64("0.0"), 0.0);
+
+    // Invalid literals leave the value untouched
+    const char* invalid[] = { "", ".", "_", "1e", "1e+", "e5", "1.5x", "1..2" };
+    for(UInt32 i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        Float64 value = 42;
+        CHECK_FALSE(number_parse_f64(invalid[i], strlen(invalid[i]), &value));
+        CHECK_EQ(value, 42);
+        Float32 value32 = 42;
+        CHECK_FALSE(number_parse_f32(invalid[i], strlen(invalid[i]), &value32));
+        CHECK_EQ(value32, 42);
+    }
+
+    // Only [str, str + len) is read
+    Float64 value;
+    CHECK(number_parse_f64("1.25e3;", 6, &value));
+    CHECK_EQ(value, 1.25e3);
+}
+
+TEST(Number, rounding) {
+    // Halfway between two floats: ties go to the even one
+    CHECK_EQ(parse_f64("9007199254740993"), 9007199254740992.0);
+    CHECK_EQ(parse_f64("9007199254740995"), 9007199254740996.0);
+    CHECK_EQ(parse_f32("16777217"), 16777216.0f);
+    CHECK_EQ(parse_f32("16777219"), 16777220.0f);
+    // 1 + 2^-53 exactly, and just above it
+    CHECK_EQ(parse_f64("1.00000000000000011102230246251565404236316680908203125"), 1.0);
+    CHECK_EQ(parse_f64("1.00000000000000011102230246251565404236316680908203126"), 1.0000000000000002);
+    // 1 + 2^-24 exactly, and just below it
+    CHECK_EQ(parse_f32("1.000000059604644775390625"), 1.0f);
+    CHECK_EQ(parse_f32("1.000000059604644775390624"), 1.0f);
+    CHECK_EQ(parse_f32("1.000000059604644775390626"), 1.00000012f);
+
+    // Significands longer than 19 digits
+    CHECK_EQ(parse_f64("12345678901234567890123"), 1.2345678901234568e22);
+    CHECK_EQ(parse_f64("3.14159265358979323846264338327950288"), 3.141592653589793);
+    CHECK_EQ(parse_f64("0.1000000000000000000000000001"), 0.1);
+    CHECK_EQ(parse_f32("3.14159265358979323846264338327950288"), 3.14159265f);
+}
+
+TEST(Number, range) {
+    // Subnormals
+    CHECK_EQ(parse_f64("4.9406564584124654e-324"), 4.9406564584124654e-324);
+    CHECK_EQ(parse_f64("2.2250738585072009e-308"), 2.2250738585072009e-308);
+    CHECK_EQ(parse_f64("1.5e-323"), 1.5e-323);
+    CHECK_EQ(parse_f32("1.4e-45"), 1.4e-45f);
+    CHECK_EQ(parse_f32("1.17549421e-38"), 1.17549421e-38f);
+    // ... rounding up to the smallest normal float
+    CHECK_EQ(parse_f64("2.2250738585072013e-308"), 2.2250738585072014e-308);
+    CHECK_EQ(parse_f32("1.1754943e-38"), 1.17549435e-38f);
+
+    // Overflow and underflow
+    CHECK(isinf(parse_f64("1e400")));
+    CHECK_EQ(parse_f64("1e-400"), 0.0);
+    CHECK(isinf(parse_f64("1.8e308")));
+    CHECK_EQ(parse_f64("1.7976931348623157e308"), 1.7976931348623157e308);
+    CHECK_EQ(parse_f64("2e-324"), 0.0);
+    CHECK(isinf(parse_f32("1e39")));
+    CHECK(isinf(parse_f32("3.5e38")));
+    CHECK_EQ(parse_f32("3.4028234e38"), 3.4028234e38f);
+    CHECK_EQ(parse_f32("1e-46"), 0.0f);
+    CHECK_EQ(parse_f32("0.000_000e99999"), 0.0f);
+}
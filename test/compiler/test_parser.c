@@ -0,0 +1,320 @@
+#include <AdoradInternalTests/AdoradInternalTests.h>
+#include <tau/tau.h>
+TAU_MAIN()
+
+// These are `static` in the Parser (see tools/tests/before_tests_ci.py)
+TokenKind parser_peek_kind(Parser* parser);
+TokenKind parser_token_kind(Parser* parser, TokenIndex index);
+AstNode* ast_parse_assignment_expr(Parser* parser);
+AstNode* ast_parse_block_expr(Parser* parser);
+AstNode* ast_parse_func_prototype(Parser* parser);
+AstNode* ast_parse_match_branch(Parser* parser);
+AstNode* ast_parse_suffix_op(Parser* parser);
+AstNode* ast_parse_var_decl(Parser* parser);
+
+static Parser* parser_for(char* buffer) {
+    Lexer* lexer = lexer_init(buffer, null);
+    lexer_lex(lexer);
+    return parser_init(lexer);
+}
+
+static void parser_for_free(Parser* parser) {
+    lexer_free(parser->lexer);
+    parser_free(parser);
+}
+
+static const char* binary_op_str(BinaryOpKind op) {
+    switch(op) {
+        case BinaryOpKindAdd: return "+";
+        case BinaryOpKindSubtract: return "-";
+        case BinaryOpKindMult: return "*";
+        case BinaryOpKindBitAnd: return "&";
+        case BinaryOpKindCmpEqual: return "==";
+        case BinaryOpKindCmpLessThan: return "<";
+        case BinaryOpKindBoolAnd: return "&&";
+        case BinaryOpKindBoolOr: return "||";
+        case BinaryOpKindAssignmentEquals: return "=";
+        default: return "?";
+    }
+}
+
+// Writes the shape of an expression as an S-expression (identifiers are `x`, calls are `call`)
+static void expr_shape(AstNode* node, char* out) {
+    if(node->kind == AstNodeKindIdentifier) {
+        strcat(out, "x");
+        return;
+    }
+    if(node->kind == AstNodeKindFuncCallExpr) {
+        strcat(out, "call");
+        return;
+    }
+    if(node->kind == AstNodeKindArrayAccessExpr) {
+        strcat(out, "(idx ");
+        expr_shape(node->data.array_access_expr->array_ref_expr, out);
+        strcat(out, " ");
+        expr_shape(node->data.array_access_expr->subscript, out);
+        strcat(out, ")");
+        return;
+    }
+    if(node->kind != AstNodeKindBinaryOpExpr) {
+        strcat(out, "?");
+        return;
+    }
+    strcat(out, "(");
+    strcat(out, binary_op_str(node->data.expr->binary_op_expr->op));
+    strcat(out, " ");
+    expr_shape(node->data.expr->binary_op_expr->lhs, out);
+    strcat(out, " ");
+    expr_shape(node->data.expr->binary_op_expr->rhs, out);
+    strcat(out, ")");
+}
+
+// Writes the shape of a statement: blocks are `{...}` and declarations are `name=expr;`
+static void stmt_shape(AstNode* node, char* out) {
+    if(node->kind == AstNodeKindBlock) {
+        Vec* statements = node->data.stmt->block_stmt->statements;
+        strcat(out, "{");
+        for(UInt64 i = 0; i < vec_size(statements); i++)
+            stmt_shape(vec_at(statements, i), out);
+        strcat(out, "}");
+        return;
+    }
+    if(node->kind != AstNodeKindVarDecl) {
+        strcat(out, "?;");
+        return;
+    }
+    strcat(out, node->data.stmt->var_decl->name->data);
+    strcat(out, "=");
+    expr_shape(node->data.stmt->var_decl->expr, out);
+    strcat(out, ";");
+}
+
+// Parses `buffer` as an expression (which has to span all of it) and returns its shape
+static const char* parse_shape(char* buffer) {
+    static char shape[256];
+    shape[0] = nullchar;
+    Parser* parser = parser_for(buffer);
+    AstNode* expr = ast_parse_assignment_expr(parser);
+    if(expr != null && parser_peek_kind(parser) == TOK_EOF)
+        expr_shape(expr, shape);
+    parser_for_free(parser);
+    return shape;
+}
+
+// Returns true if parsing `buffer` as an expression raises a syntax error
+static bool parse_fails(char* buffer) {
+    Parser* parser = parser_for(buffer);
+    jmp_buf recover;
+    parser->recover = &recover;
+    if(setjmp(recover) != 0) {
+        parser_for_free(parser);
+        return true;
+    }
+    ast_parse_assignment_expr(parser);
+    parser_for_free(parser);
+    return false;
+}
+
+TEST(Parser, binary_expr) {
+    // Operators of the same precedence group to the left, assignments to the right
+    CHECK_STREQ(parse_shape("a - b - c"), "(- (- x x) x)");
+    CHECK_STREQ(parse_shape("a = b = c"), "(= x (= x x))");
+
+    // Tighter operators bind first, whichever side they're on
+    CHECK_STREQ(parse_shape("a + b * c"), "(+ x (* x x))");
+    CHECK_STREQ(parse_shape("a * b + c"), "(+ (* x x) x)");
+    CHECK_STREQ(parse_shape("a & b == c"), "(== (& x x) x)");
+    CHECK_STREQ(parse_shape("a && b || c"), "(|| (&& x x) x)");
+    CHECK_STREQ(parse_shape("a || b && c"), "(|| x (&& x x))");
+
+    // Operands are whatever a TypeExpr parses
+    CHECK_STREQ(parse_shape("f(a) * b"), "(* call x)");
+
+    // Comparisons don't chain
+    CHECK_STREQ(parse_shape("a < b"), "(< x x)");
+    CHECK_FALSE(parse_fails("a < b"));
+    CHECK(parse_fails("a < b < c"));
+    CHECK(parse_fails("a == b != c"));
+    CHECK(parse_fails("a +"));
+}
+
+TEST(Parser, lazy_bodies) {
+    char* buffer = "func f() int { int a = b + c; int d = e[i]; { int g = h; } } x";
+    const char* shape = "{a=(+ x x);d=(idx x x);{g=x;}}";
+
+    // Parsed as it comes
+    Parser* eager = parser_for(buffer);
+    AstNodeFuncPrototype* proto = ast_parse_func_prototype(eager)->data.stmt->func_proto_decl;
+    CHECK_STREQ(proto->name->data, "f");
+    CHECK_EQ(proto->body_begin, TOKEN_NONE);
+    CHECK_NOT_NULL(proto->func_def);
+    char eager_shape[256] = "";
+    stmt_shape(proto->func_def, eager_shape);
+    CHECK_STREQ(eager_shape, shape);
+    CHECK_EQ(parser_peek_kind(eager), IDENTIFIER);
+    TokenIndex after_body = eager->iter.index;
+
+    // Skipped, then parsed on demand
+    Parser* lazy = parser_for(buffer);
+    parser_set_lazy_bodies(lazy, true);
+    AstNode* func = ast_parse_func_prototype(lazy);
+    proto = func->data.stmt->func_proto_decl;
+    CHECK_NULL(proto->func_def);
+    CHECK_EQ(proto->body_begin, 5);
+    CHECK_EQ(parser_token_kind(lazy, proto->body_begin), LBRACE);
+    CHECK_EQ(proto->body_end, after_body - 1);
+    CHECK_EQ(parser_token_kind(lazy, proto->body_end), RBRACE);
+    CHECK_EQ(lazy->iter.index, after_body);
+
+    AstNode* body = parser_parse_body(lazy, func);
+    CHECK_NOT_NULL(body);
+    CHECK(body == proto->func_def);
+    CHECK_EQ(proto->body_begin, TOKEN_NONE);
+    CHECK_EQ(lazy->iter.index, after_body);
+    char lazy_shape[256] = "";
+    stmt_shape(body, lazy_shape);
+    CHECK_STREQ(lazy_shape, shape);
+    // Parsed once
+    CHECK(parser_parse_body(lazy, func) == body);
+
+    parser_for_free(eager);
+    parser_for_free(lazy);
+
+    // Unbalanced braces: the body is parsed eagerly (and the stray `}` is left to the caller)
+    Parser* unbalanced = parser_for("func f() int { int a = b; } }");
+    parser_set_lazy_bodies(unbalanced, true);
+    proto = ast_parse_func_prototype(unbalanced)->data.stmt->func_proto_decl;
+    CHECK_EQ(proto->body_begin, TOKEN_NONE);
+    CHECK_NOT_NULL(proto->func_def);
+    CHECK_EQ(parser_peek_kind(unbalanced), RBRACE);
+    parser_for_free(unbalanced);
+
+    // Bodies with loops are refused, whenever they're parsed
+    Parser* loop = parser_for("func f() int { for { int a = b; } }");
+    parser_set_lazy_bodies(loop, true);
+    AstNode* loop_func = ast_parse_func_prototype(loop);
+    jmp_buf recover;
+    loop->recover = &recover;
+    volatile bool refused = false;
+    if(setjmp(recover) != 0)
+        refused = true;
+    else
+        parser_parse_body(loop, loop_func);
+    CHECK(refused);
+    parser_for_free(loop);
+}
+
+TEST(Parser, match_branch) {
+    // No branch: nothing is consumed (prototypes parse their parameter lists with this)
+    Parser* parser = parser_for(")");
+    CHECK_NULL(ast_parse_match_branch(parser));
+    CHECK_EQ(parser->iter.index, 0);
+    parser_for_free(parser);
+}
+
+TEST(Parser, suffix_op) {
+    CHECK_STREQ(parse_shape("a[i]"), "(idx x x)");
+    CHECK_STREQ(parse_shape("a[i + j] * b"), "(* (idx x (+ x x)) x)");
+
+    // `{` isn't a suffix (it could be the body of a function)
+    Parser* parser = parser_for("{ i }");
+    CHECK_NULL(ast_parse_suffix_op(parser));
+    CHECK_EQ(parser->iter.index, 0);
+    parser_for_free(parser);
+}
+
+TEST(Parser, streaming) {
+    // Declarations much longer than the token window: names are read before they leave it
+    const char* decl = "int a = 1";
+    const char* term = " + 1";
+    UInt32 terms = 200;
+    char* buffer = cast(char*)calloc(strlen(decl) + terms * strlen(term) + 32, 1);
+    strcpy(buffer, decl);
+    for(UInt32 i = 0; i < terms; i++)
+        strcat(buffer, term);
+    strcat(buffer, "; outer: { int b = a; }");
+
+    Lexer* lexer = lexer_init_streaming(buffer, null, 16);
+    Parser* parser = parser_init(lexer);
+    AstNode* var_decl = ast_parse_var_decl(parser);
+    CHECK_NOT_NULL(var_decl);
+    CHECK_STREQ(var_decl->data.stmt->var_decl->name->data, "a");
+    CHECK_EQ(var_decl->data.stmt->var_decl->expr->kind, AstNodeKindBinaryOpExpr);
+    CHECK(parser->iter.index > 16);
+
+    AstNode* block = ast_parse_block_expr(parser);
+    CHECK_NOT_NULL(block);
+    CHECK_STREQ(block->data.stmt->block_stmt->name->data, "outer");
+    char shape[64] = "";
+    stmt_shape(block, shape);
+    CHECK_STREQ(shape, "{b=x;}");
+    CHECK_EQ(parser_peek_kind(parser), TOK_EOF);
+
+    parser_for_free(parser);
+    free(buffer);
+}
+
+// No. of bytes handed out by an Arena
+static UInt64 arena_bytes(Arena* arena) {
+    UInt64 bytes = 0;
+    for(cstlArenaBlock* block = arena->head; block != null; block = block->prev)
+        bytes += block->used;
+    return bytes;
+}
+
+TEST(Parser, flat_ast) {
+    char* buffer =
+        "func add() int {\n"
+        "    int a = b + c * d;\n"
+        "    mutable int e = f(a, b)[i + 1];\n"
+        "    if(a < e) { int g = a; } else { int g = e; }\n"
+        "    {\n"
+        "        int h = match(a) { 1, 2 => x, 3...4 => y, else => z };\n"
+        "        break h\n"
+        "    }\n"
+        "    return !a && b || c\n"
+        "}\n"
+        "func sub() float { const float s = 1.5 - t * 2; return s }\n";
+    Parser* parser = parser_for(buffer);
+    FlatAst* flat = flatast_new(16);
+    AstNode* func;
+    UInt32 num_funcs = 0;
+    while((func = ast_parse_func_prototype(parser)) != null) {
+        AstIndex root = flatast_from_node(flat, func);
+        CHECK_EQ(flatast_at(flat, root).kind, AstNodeKindFuncPrototype);
+        num_funcs++;
+    }
+    CHECK_EQ(num_funcs, 2);
+    CHECK_EQ(parser_peek_kind(parser), TOK_EOF);
+
+    // Every node the Parser built, and nothing else
+    CHECK_EQ(flat->size, parser->num_nodes);
+    CHECK_EQ(flatast_at(flat, 0).main_token, 1);
+    CHECK_EQ(parser_token_kind(parser, flatast_at(flat, 0).main_token), IDENTIFIER);
+
+    // `add()`: no params, and a body of 5 statements
+    FlatAstNode add = flatast_at(flat, 0);
+    UInt32 count;
+    flatast_list(flat, flat->extra_data[add.lhs], &count);
+    CHECK_EQ(count, 0);
+    FlatAstNode body = flatast_at(flat, flat->extra_data[add.lhs + 1]);
+    CHECK_EQ(body.kind, AstNodeKindBlock);
+    CHECK_EQ(parser_token_kind(parser, body.main_token), LBRACE);
+    const AstIndex* statements = flatast_list(flat, body.lhs, &count);
+    CHECK_EQ(count, 5);
+    // `int a = b + c * d;`
+    FlatAstNode decl = flatast_at(flat, statements[0]);
+    CHECK_EQ(decl.kind, AstNodeKindVarDecl);
+    CHECK_EQ(flatast_at(flat, decl.lhs).kind, AstNodeKindIdentifier);
+    CHECK_EQ(flatast_at(flat, decl.rhs).kind, AstNodeKindBinaryOpExpr);
+    CHECK_EQ(parser_token_kind(parser, flatast_at(flat, decl.rhs).main_token), PLUS);
+
+    // The FlatAst is a fraction of the size of the pointer AST
+    UInt64 flat_bytes = flat->size * (sizeof(UInt8) + sizeof(TokenIndex) + 2 * sizeof(UInt32)) +
+                        flat->num_extra * sizeof(UInt32);
+    UInt64 pointer_bytes = arena_bytes(parser->arena);
+    CHECK_LT(flat_bytes / flat->size, pointer_bytes / parser->num_nodes / 4);
+
+    flatast_free(flat);
+    parser_for_free(parser);
+}
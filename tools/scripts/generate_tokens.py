@@ -245,9 +245,349 @@ def make_token_py(infile, outfile='adorad/compiler/tokens/tokens.py'):
         print("%s regenerated from %s" % (outfile, infile))
 
 
-def mainfunc(op, infile='adorad/compiler/tokens', *args):
+# Lookup tables for the Lexer, generated from the `ALLTOKENS` X-macro in adorad/compiler/tokens.h
+#   1. Keywords: a multiplicative hash over (first char, second char, third char, last char, length). We search for a
+#      multiplier that maps every keyword to a distinct slot, so a lookup is one hash + at most one memcmp.
+#   2. Operators, delimiters and separators: a DFA (a trie over the operator strings) driven by a 256-entry
+#      char-class map and a state-transition table.
+import re
+
+TOKENKIND_RE = re.compile(r'TOKENKIND\((\w+)(?:\s*=\s*\d+)?,\s*"((?:[^"\\]|\\.)*)"\)')
+
+def load_alltokens(path):
+    with open(path) as fp:
+        return TOKENKIND_RE.findall(fp.read())
+
+
+def load_token_range(path, begin, end):
+    tokens = load_alltokens(path)
+    names = [name for name, _ in tokens]
+    begin = names.index(begin)
+    end = names.index(end)
+    # Skip markers and classification entries (like `KEYWORD`) which have no string representation
+    return [(name, string.encode().decode('unicode_escape')) for name, string in tokens[begin + 1:end] if string]
+
+
+def load_keywords(path):
+    return load_token_range(path, 'TOK___KEYWORDS_BEGIN', 'TOK___KEYWORDS_END')
+
+
+# Operators that begin a comment or a macro are lexed by dedicated routines in `lexer.c`, not by the DFA
+DFA_EXCLUDED_OPERATORS = ('//', '@', '#')
+
+def load_operators(path):
+    operators = load_token_range(path, 'TOK___OPERATORS_BEGIN', 'TOK___SEPARATORS_END')
+    return [(name, op) for name, op in operators if op not in DFA_EXCLUDED_OPERATORS]
+
+
+def build_operator_dfa(operators):
+    # Character classes: class 0 is every byte that can't appear in an operator
+    chars = sorted({c for _, op in operators for c in op})
+    char_class = {c: i + 1 for i, c in enumerate(chars)}
+
+    # States are the nodes of a trie over the operator strings; state 0 is the start state
+    transitions = [[0] * (len(chars) + 1)]
+    accept = ['TOK_NULL']
+    for name, op in sorted(operators, key=lambda entry: entry[1]):
+        state = 0
+        for c in op:
+            cls = char_class[c]
+            if transitions[state][cls] == 0:
+                transitions.append([0] * (len(chars) + 1))
+                accept.append('TOK_NULL')
+                transitions[state][cls] = len(transitions) - 1
+            state = transitions[state][cls]
+        accept[state] = name
+
+    # The Lexer stops at the first byte without a transition and emits the current state, so every prefix of an
+    # operator must itself be an operator
+    for state in range(1, len(accept)):
+        if accept[state] == 'TOK_NULL':
+            raise ValueError("Operators must be prefix-closed (state %d accepts nothing)" % state)
+    if len(transitions) > 256:
+        raise ValueError("Too many DFA states for a UInt8 state table")
+
+    return char_class, transitions, accept
+
+
+# Must stay in sync with `KEYWORD_HASH_KEY` in lexer_tables_template
+def keyword_hash_key(kw):
+    c2 = kw[2] if len(kw) > 2 else kw[1]
+    return (ord(kw[0]) | (ord(kw[1]) << 8) | (ord(c2) << 16)) ^ (ord(kw[-1]) << 24) ^ len(kw)
+
+
+def keyword_hash(key, mult, bits):
+    return ((key * mult) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def find_keyword_hash(keywords):
+    keys = [keyword_hash_key(kw) for _, kw in keywords]
+    for bits in range(max(len(keys) - 1, 1).bit_length(), 11):
+        for i in range(1, 1 << 22):
+            mult = ((i * 0x9E3779B1) & 0xFFFFFFFF) | 1
+            if len({keyword_hash(key, mult, bits) for key in keys}) == len(keys):
+                return mult, bits
+    raise ValueError("Could not find a perfect hash for the keywords")
+
+
+lexer_tables_template = """\
+/*
+          _____   ____  _____            _____
+    /\\   |  __ \\ / __ \\|  __ \\     /\\   |  __ \\
+   /  \\  | |  | | |  | | |__) |   /  \\  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\\ \\ | |  | | |  | |  _  /   / /\\ \\ | |  | | Languages: C, C++, and Assembly
+ / ____ \\| |__| | |__| | | \\ \\  / ____ \\| |__| | https://github.com/adorad/adorad/
+/_/    \\_\\_____/ \\____/|_|  \\_\\/_/    \\_\\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+
+// Auto-generated by tools/scripts/generate_tokens.py from `ALLTOKENS` (adorad/compiler/tokens.h). Do not edit.
+// Regenerate with: python3 tools/scripts/generate_tokens.py lexer_tables
+// NB: This is only meant to be included by `lexer.c`
+#ifndef ADORAD_LEXER_TABLES_H
+#define ADORAD_LEXER_TABLES_H
+
+#define KEYWORD_MIN_LENGTH      %d
+#define KEYWORD_MAX_LENGTH      %d
+
+// Perfect hash over (first char, second char, third char, last char, length) of a keyword candidate
+// `value` must have at least KEYWORD_MIN_LENGTH (2) characters
+#define KEYWORD_HASH_MULT       0x%08XU
+#define KEYWORD_HASH_BITS       %d
+#define KEYWORD_HASH_KEY(value, len)                                                           \\
+    (((UInt32)(UInt8)(value)[0] | ((UInt32)(UInt8)(value)[1] << 8) |                            \\
+      ((UInt32)(UInt8)(value)[(len) > 2 ? 2 : 1] << 16)) ^                                     \\
+     ((UInt32)(UInt8)(value)[(len) - 1] << 24) ^ (UInt32)(len))
+#define KEYWORD_HASH(value, len)    \\
+    ((UInt32)(KEYWORD_HASH_KEY(value, len) * KEYWORD_HASH_MULT) >> (32 - KEYWORD_HASH_BITS))
+
+// Keyword TokenKind in each hash slot (TOK_NULL if the slot is empty)
+static const UInt8 keywordSlotKinds[%d] = {
+%s
+};
+
+// Length of the keyword in each hash slot (0 if the slot is empty)
+static const UInt8 keywordSlotLengths[%d] = {
+%s
+};
+
+// Operator DFA
+// `lexerCharClass` maps every byte to its character class (0 for bytes that can't appear in an operator).
+// `lexerDfaTransitions[state][class]` is the next state (0 means "stop here"), and `lexerDfaAccept[state]` is the
+// TokenKind emitted when the DFA stops in `state`. State 0 is the start state.
+#define LEXER_DFA_NUM_CLASSES   %d
+#define LEXER_DFA_NUM_STATES    %d
+
+static const UInt8 lexerCharClass[256] = {
+%s
+};
+
+static const UInt8 lexerDfaTransitions[LEXER_DFA_NUM_STATES][LEXER_DFA_NUM_CLASSES] = {
+%s
+};
+
+static const UInt8 lexerDfaAccept[LEXER_DFA_NUM_STATES] = {
+%s
+};
+
+#endif // ADORAD_LEXER_TABLES_H
+"""
+
+
+def format_table(entries, per_line):
+    lines = []
+    for i in range(0, len(entries), per_line):
+        lines.append(('    ' + ' '.join(entries[i:i + per_line])).rstrip())
+    return '\n'.join(lines)
+
+
+def c_char(c):
+    if c in ("'", '\\'):
+        return "'\\%s'" % c
+    return "'%s'" % c
+
+
+def make_lexer_tables(infile='adorad/compiler/tokens.h', outfile='adorad/compiler/lexer_tables.h'):
+    keywords = load_keywords(infile)
+    mult, bits = find_keyword_hash(keywords)
+
+    nslots = 1 << bits
+    slot_kinds = ['TOK_NULL'] * nslots
+    slot_lengths = [0] * nslots
+    for name, kw in keywords:
+        slot = keyword_hash(keyword_hash_key(kw), mult, bits)
+        slot_kinds[slot] = name
+        slot_lengths[slot] = len(kw)
+
+    char_class, transitions, accept = build_operator_dfa(load_operators(infile))
+    # Name each state by the operator it has matched so far
+    state_names = ['start'] + [''] * (len(transitions) - 1)
+    for state, row in enumerate(transitions):
+        for c, cls in char_class.items():
+            if row[cls]:
+                state_names[row[cls]] = state_names[state].replace('start', '') + c
+
+    if update_file(outfile, lexer_tables_template % (
+            min(len(kw) for _, kw in keywords),
+            max(len(kw) for _, kw in keywords),
+            mult,
+            bits,
+            nslots,
+            format_table(['%-10s' % (k + ',') for k in slot_kinds], 8),
+            nslots,
+            format_table(['%2d,' % n for n in slot_lengths], 16),
+            len(char_class) + 1,
+            len(transitions),
+            '\n'.join('    [%s] = %d,' % (c_char(c), cls) for c, cls in sorted(char_class.items())),
+            '\n'.join('    /* %-5s */ { %s },' % (name, ', '.join('%2d' % n for n in row))
+                      for name, row in zip(state_names, transitions)),
+            '\n'.join('    /* %-5s */ %s,' % (name, kind) for name, kind in zip(state_names, accept)),
+        )):
+        print("%s regenerated from %s" % (outfile, infile))
+
+
+# Operator tables for the Parser, indexed by TokenKind
+# Every binary operator: (TokenKind, precedence, associativity, BinaryOpKind). Higher precedence numbers are stickier.
+PARSER_PREC_ASSIGNMENT = 5
+PARSER_BINARY_OPS = (
+    ('MULT',                     60, 'Left',  'BinaryOpKindMult'),
+    ('MOD',                      60, 'Left',  'BinaryOpKindMod'),
+    ('SLASH',                    60, 'Left',  'BinaryOpKindDiv'),
+
+    ('PLUS',                     50, 'Left',  'BinaryOpKindAdd'),
+    ('MINUS',                    50, 'Left',  'BinaryOpKindSubtract'),
+
+    ('LBITSHIFT',                40, 'Left',  'BinaryOpKindBitshitLeft'),
+    ('RBITSHIFT',                40, 'Left',  'BinaryOpKindBitshitRight'),
+
+    ('AND',                      35, 'Left',  'BinaryOpKindBitAnd'),
+    ('XOR',                      35, 'Left',  'BinaryOpKindBitXor'),
+    ('OR',                       35, 'Left',  'BinaryOpKindBitOr'),
+
+    ('EQUALS_EQUALS',            30, 'None',  'BinaryOpKindCmpEqual'),
+    ('EXCLAMATION_EQUALS',       30, 'None',  'BinaryOpKindCmpNotEqual'),
+    ('GREATER_THAN',             30, 'None',  'BinaryOpKindCmpGreaterThan'),
+    ('LESS_THAN',                30, 'None',  'BinaryOpKindCmpLessThan'),
+    ('GREATER_THAN_OR_EQUAL_TO', 30, 'None',  'BinaryOpKindCmpGreaterThanorEqualTo'),
+    ('LESS_THAN_OR_EQUAL_TO',    30, 'None',  'BinaryOpKindCmpLessThanorEqualTo'),
+
+    ('AND_AND',                  20, 'Left',  'BinaryOpKindBoolAnd'),
+
+    ('OR_OR',                    10, 'Left',  'BinaryOpKindBoolOr'),
+
+    ('EQUALS',                   PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentEquals'),
+    ('PLUS_EQUALS',              PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentPlus'),
+    ('MINUS_EQUALS',             PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentMinus'),
+    ('MULT_EQUALS',              PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentMult'),
+    ('SLASH_EQUALS',             PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentDiv'),
+    ('MOD_EQUALS',               PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentMod'),
+    ('AND_EQUALS',               PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentBitAnd'),
+    ('OR_EQUALS',                PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentBitOr'),
+    ('XOR_EQUALS',               PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentBitXor'),
+    ('LBITSHIFT_EQUALS',         PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentBitshiftLeft'),
+    ('RBITSHIFT_EQUALS',         PARSER_PREC_ASSIGNMENT, 'Right', 'BinaryOpKindAssignmentBitshiftRight'),
+)
+
+# Every prefix operator: (TokenKind, PrefixOpKind)
+PARSER_PREFIX_OPS = (
+    ('NOT',         'PrefixOpKindBoolNot'),
+    ('EXCLAMATION', 'PrefixOpKindNegation'),
+    ('AND',         'PrefixOpKindAddrOf'),
+    ('TRY',         'PrefixOpKindTry'),
+)
+
+parser_tables_template = """\
+/*
+          _____   ____  _____            _____
+    /\\   |  __ \\ / __ \\|  __ \\     /\\   |  __ \\
+   /  \\  | |  | | |  | | |__) |   /  \\  | |  | | Adorad - The Fast, Expressive & Elegant Programming Language
+  / /\\ \\ | |  | | |  | |  _  /   / /\\ \\ | |  | | Languages: C, C++, and Assembly
+ / ____ \\| |__| | |__| | | \\ \\  / ____ \\| |__| | https://github.com/adorad/adorad/
+/_/    \\_\\_____/ \\____/|_|  \\_\\/_/    \\_\\_____/
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Jason Dsouza <@jasmcaus>
+*/
+
+// Auto-generated by tools/scripts/generate_tokens.py from `ALLTOKENS` (adorad/compiler/tokens.h). Do not edit.
+// Regenerate with: python3 tools/scripts/generate_tokens.py parser_tables
+// NB: This is only meant to be included by `parser.c` (after `AstAssoc`)
+#ifndef ADORAD_PARSER_TABLES_H
+#define ADORAD_PARSER_TABLES_H
+
+// Generated for this many TokenKinds: regenerate the tables if this fails
+CORETEN_STATIC_ASSERT(TOK_COUNT == %d);
+
+// Precedence of the assignment operators, which bind the loosest (and aren't part of an `Expr`)
+#define PARSER_PREC_ASSIGNMENT  %d
+
+// Precedence of each binary operator (0 unless the token is one). Higher precedence numbers are stickier.
+static const UInt8 parserPrecedence[TOK_COUNT] = {
+%s
+};
+
+// How each binary operator groups with the operators of the same precedence (AstAssoc)
+static const UInt8 parserAssoc[TOK_COUNT] = {
+%s
+};
+
+// BinaryOpKind of each binary operator (BinaryOpKindInvalid unless the token is one)
+static const UInt8 parserBinaryOpKinds[TOK_COUNT] = {
+%s
+};
+
+// PrefixOpKind of each prefix operator (PrefixOpKindInvalid unless the token is one)
+static const UInt8 parserPrefixOpKinds[TOK_COUNT] = {
+%s
+};
+
+// Set for the assignment operators
+static const bool parserIsAssignmentOp[TOK_COUNT] = {
+%s
+};
+
+CORETEN_STATIC_ASSERT(sizeof(parserPrecedence) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(sizeof(parserAssoc) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(sizeof(parserBinaryOpKinds) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(sizeof(parserPrefixOpKinds) == TOK_COUNT);
+CORETEN_STATIC_ASSERT(BinaryOpKindInvalid == 0 && PrefixOpKindInvalid == 0);
+
+#endif // ADORAD_PARSER_TABLES_H
+"""
+
+
+def make_parser_tables(infile='adorad/compiler/tokens.h', outfile='adorad/compiler/parser_tables.h'):
+    names = [name for name, _ in load_alltokens(infile)]
+    for name, *_ in PARSER_BINARY_OPS + PARSER_PREFIX_OPS:
+        if name not in names:
+            raise ValueError("Unknown TokenKind `%s`" % name)
+
+    width = max(len(name) for name, *_ in PARSER_BINARY_OPS + PARSER_PREFIX_OPS) + 2
+    def entries(ops, value):
+        return '\n'.join('    %-*s = %s,' % (width, '[%s]' % op[0], value(op)) for op in ops)
+
+    if update_file(outfile, parser_tables_template % (
+            names.index('TOK_COUNT'),
+            PARSER_PREC_ASSIGNMENT,
+            entries(PARSER_BINARY_OPS, lambda op: op[1]),
+            entries(PARSER_BINARY_OPS, lambda op: 'AstAssoc' + op[2]),
+            entries(PARSER_BINARY_OPS, lambda op: op[3]),
+            entries(PARSER_PREFIX_OPS, lambda op: op[1]),
+            entries([op for op in PARSER_BINARY_OPS if op[1] == PARSER_PREC_ASSIGNMENT], lambda op: 'true'),
+        )):
+        print("%s regenerated from %s" % (outfile, infile))
+
+
+def mainfunc(op, infile=None, *args):
     make = globals()['make_' + op]
-    make(infile, *args)
+    if infile is None:
+        make()
+    else:
+        make(infile, *args)
 
 #pylint:disable=no-value-for-parameter
 if __name__ == '__main__':